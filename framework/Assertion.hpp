@@ -5,7 +5,11 @@ namespace kernel
 #ifdef KDEBUG
 static void stop()
 {
+#if defined(__arm__)
 	asm volatile("bkpt #0");
+#else
+	__builtin_trap();
+#endif
 }
 	#define Y_ASSERT(cond) ((cond) ? (void)0U : kernel::stop())
 #else
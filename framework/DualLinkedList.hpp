@@ -36,15 +36,25 @@ Software without prior written authorization from Florian GERARD
 
 namespace framework
 {
+	template<typename UnderLyingType, typename List>
+		class DualLinkedList;
+
+	template<typename UnderLyingType, typename List>
+		class DualLinkedHead;
+
 	template<typename UnderLyingType, typename List>
 		class DualLinkNode
 		{
 			friend class T;
 			template<typename T,typename L> friend class DualLinkedList;
+			template<typename T,typename L> friend class DualLinkedHead;
 			
 		private:
-			DualLinkNode<UnderLyingType,List>* m_previous;
+			DualLinkNode<UnderLyingType,List>* m_previous; // points to the node itself while unlinked
 			DualLinkNode<UnderLyingType,List>* m_next;
+#ifdef KDEBUG
+			const void* m_owner; // list holding the node, only kept to check lists of a same link type are not mixed up
+#endif
 			
 			//place node before this
 			void prepend(DualLinkNode<UnderLyingType, List>* node)
@@ -80,8 +90,21 @@ namespace framework
 			
 			constexpr DualLinkNode()
 			{
-				m_previous = nullptr;
+				m_previous = this;
 				m_next = nullptr;
+#ifdef KDEBUG
+				m_owner = nullptr;
+#endif
+			}
+			
+			/*node does not store its list, linked only tells it is in a list of this link type
+			 *owner of the node knows which one from its own state*/
+			static bool isLinked(UnderLyingType* node)
+			{
+				if (node == nullptr)
+					return false;
+				DualLinkNode<UnderLyingType, List>* link = static_cast<DualLinkNode<UnderLyingType, List>*>(node);
+				return link->m_previous != link;
 			}
 			
 			
@@ -122,6 +145,7 @@ namespace framework
 			
 		private:
 			DualLinkNode<UnderLyingType,List>* m_first;
+			DualLinkNode<UnderLyingType,List>* m_last;
 			uint32_t m_count;
 			
 		public:
@@ -132,127 +156,81 @@ namespace framework
 			 *if return value is <0 compared superior to base*/
 			typedef int8_t(*Comparator)(UnderLyingType* base, UnderLyingType* compared);
 			
-			constexpr DualLinkedList() : m_first(nullptr), m_count(0)
+			constexpr DualLinkedList() : m_first(nullptr), m_last(nullptr), m_count(0)
 			{
 			}
 			
+			/*insert node after every node it is not inferior to
+			 *checking the tail first keep insertion of an already ordered flow constant time*/
 			void insert(UnderLyingType* node, Comparator comparator)
 			{
-
 				Y_ASSERT(node != nullptr);
 				DualLinkNode<UnderLyingType, List>* newNode = static_cast<DualLinkNode<UnderLyingType, List>*>(node);
-				newNode->m_next = nullptr;
-				newNode->m_previous = nullptr;
-				if (m_count == 0)
-				{
-					m_first = newNode;
-					m_count = 1;
-					return;
-				}
-				else
+				Y_ASSERT(newNode->m_previous == newNode); // lists of a same link type share the node, it must be free
+				if (m_count == 0 || comparator(static_cast<UnderLyingType*>(m_last), node) <= 0)
 				{
-					uint32_t i = 0;
-					DualLinkNode<UnderLyingType,List>* iterator = m_first;
-					int8_t result = 0;
-					
-					/*Go throught the list until last element*/
-					while (i < m_count-1)
-					{
-						result = comparator(static_cast<UnderLyingType*>(iterator), static_cast<UnderLyingType*>(newNode));
-						if (result > 0)
-						{
-							iterator->prepend(newNode);
-							m_count++;
-							if (iterator == m_first)
-								m_first = newNode;
-							return;
-						}
-						else
-						{
-							iterator = iterator->m_next;
-							i++;
-						}
-					}
-					//this is the last element
-					result = comparator(static_cast<UnderLyingType*>(iterator), static_cast<UnderLyingType*>(newNode));
-					if (result < 1)
-						iterator->append(newNode);
-					else
-					{	
-						iterator->prepend(newNode);
-						if (iterator == m_first)
-							m_first = newNode;
-					}
-					m_count++;
+					insertEnd(node);
 					return;
 				}
+				DualLinkNode<UnderLyingType,List>* iterator = m_first;
+				/*Go throught the list until a node greater than the new one, tail is known to be greater*/
+				while (comparator(static_cast<UnderLyingType*>(iterator), node) <= 0)
+					iterator = iterator->m_next;
+				newNode->m_next = nullptr;
+				newNode->m_previous = nullptr;
+				iterator->prepend(newNode);
+				if (iterator == m_first)
+					m_first = newNode;
+#ifdef KDEBUG
+				newNode->m_owner = this;
+#endif
+				m_count++;
 			}
 
 			void insertEnd(UnderLyingType *node)
 			{
 				Y_ASSERT(node != nullptr);
-				Y_ASSERT(!contain(node));
 				DualLinkNode<UnderLyingType, List> *newNode = static_cast<DualLinkNode<UnderLyingType, List> *>(node);
+				Y_ASSERT(newNode->m_previous == newNode); // lists of a same link type share the node, it must be free
 				newNode->m_next = nullptr;
 				newNode->m_previous = nullptr;
 				if (m_count == 0)
-				{
 					m_first = newNode;
-					m_count = 1;
-					return;
-				}
 				else
-				{
-					DualLinkNode<UnderLyingType, List> *iterator = m_first;
-					/*Go throught the list until last element*/
-					while (iterator->m_next != nullptr)
-					{
-						iterator = iterator->m_next;
-					}
-					iterator->append(newNode);
-					m_count++;
-					return;
-				}
+					m_last->append(newNode);
+				m_last = newNode;
+#ifdef KDEBUG
+				newNode->m_owner = this;
+#endif
+				m_count++;
 			}
 
+			/*unlink node in place, return false if node is not linked or is the head or tail of another list
+			 *a node inside another list of the same link type is only caught by debug builds, callers know the list from node state*/
 			bool remove(UnderLyingType* node)
 			{
-				DualLinkNode < UnderLyingType, List> *iterator;
-				[[maybe_unused]] uint32_t count = 0; // used for debug purposes
-				if(m_first == nullptr){
+				if (!DualLinkNode<UnderLyingType, List>::isLinked(node))
 					return false;
-				}
-				if (node == m_first)
-				{
-					iterator = m_first;
-					m_first = m_first->m_next;
-					iterator->m_next = nullptr;
-					iterator->m_previous = nullptr;
-					if (m_first != nullptr)
-						m_first->m_previous = nullptr;
-					m_count--;
-					return true;
-				}
-				else
-				{
-					iterator = m_first;
-					while (iterator->m_next != nullptr)
-					{
-						iterator = iterator->m_next;
-						if (iterator == node)
-						{
-							if(iterator->m_next != nullptr)
-								iterator->m_next->m_previous = iterator->m_previous;
-							if(iterator->m_previous != nullptr)
-								(iterator->m_previous)->m_next = iterator->m_next;
-							iterator->m_next = nullptr;
-							iterator->m_previous = nullptr;
-							m_count--;
-							return true;
-						}
-					}
+				DualLinkNode<UnderLyingType, List>* toRemove = static_cast<DualLinkNode<UnderLyingType, List>*>(node);
+#ifdef KDEBUG
+				Y_ASSERT(toRemove->m_owner == this);
+#endif
+				if ((toRemove->m_previous == nullptr && m_first != toRemove) || (toRemove->m_next == nullptr && m_last != toRemove))
 					return false;
-				}
+				if (toRemove->m_previous != nullptr)
+					toRemove->m_previous->m_next = toRemove->m_next;
+				else
+					m_first = toRemove->m_next;
+				if (toRemove->m_next != nullptr)
+					toRemove->m_next->m_previous = toRemove->m_previous;
+				else
+					m_last = toRemove->m_previous;
+				toRemove->m_next = nullptr;
+				toRemove->m_previous = toRemove;
+#ifdef KDEBUG
+				toRemove->m_owner = nullptr;
+#endif
+				m_count--;
 				return true;
 			}
 			
@@ -265,27 +243,34 @@ namespace framework
 					return false;
 			}
 			
+			/*debug builds compare the list kept in the node, release builds walk the list
+			 *constant time membership is DualLinkNode::isLinked together with the state of the node owner*/
 			bool contain(UnderLyingType* node)
 			{
-				if (node == nullptr)
+				if (!DualLinkNode<UnderLyingType, List>::isLinked(node))
 					return false;
-				DualLinkNode<UnderLyingType, List>* toFindNode = static_cast<DualLinkNode<UnderLyingType, List>*>(node);
-				DualLinkNode<UnderLyingType, List>* iteratorPtr = m_first;
-				uint32_t iteratorCounter = 0;
-				while (iteratorCounter < m_count)
+				DualLinkNode<UnderLyingType, List>* toFind = static_cast<DualLinkNode<UnderLyingType, List>*>(node);
+#ifdef KDEBUG
+				return toFind->m_owner == this;
+#else
+				for (DualLinkNode<UnderLyingType, List>* iterator = m_first; iterator != nullptr; iterator = iterator->m_next)
 				{
-					if (iteratorPtr == toFindNode)
+					if (iterator == toFind)
 						return true;
-					iteratorPtr = iteratorPtr->m_next;
-					iteratorCounter++; 
 				}
 				return false;
+#endif
 			}
 			
 			UnderLyingType* peekFirst()
 			{
 				return static_cast<UnderLyingType*>(m_first);
 			}
+
+			UnderLyingType* peekLast()
+			{
+				return static_cast<UnderLyingType*>(m_last);
+			}
 			
 			UnderLyingType* getFirst()
 			{
@@ -299,9 +284,14 @@ namespace framework
 					m_first = m_first->m_next;
 					if(m_first != nullptr)
 						m_first->m_previous = nullptr;
+					else
+						m_last = nullptr;
 					
 					ptr->m_next = nullptr;
-					ptr->m_previous = nullptr;
+					ptr->m_previous = ptr;
+#ifdef KDEBUG
+					ptr->m_owner = nullptr;
+#endif
 					return static_cast<UnderLyingType*>(ptr);
 				}
 			}
@@ -328,7 +318,7 @@ namespace framework
 				while (ptr != nullptr)
 				{
 					t_function(ptr);
-					ptr = static_cast<UnderLyingType*>(ptr->m_next);
+					ptr = DualLinkNode<UnderLyingType, List>::next(ptr);
 				}
 			}
 
@@ -337,4 +327,70 @@ namespace framework
 				return m_count;
 			}
 		};
+
+	/*Unordered list kept by its first node only, for small lists embedded in many objects
+	 *no tail and no count, insertion is at head and removal stays constant time through node links*/
+	template<typename UnderLyingType, typename List>
+		class DualLinkedHead
+		{
+			
+		private:
+			DualLinkNode<UnderLyingType,List>* m_first;
+			
+		public:
+			
+			constexpr DualLinkedHead() : m_first(nullptr)
+			{
+			}
+			
+			void insertFirst(UnderLyingType* node)
+			{
+				Y_ASSERT(node != nullptr);
+				DualLinkNode<UnderLyingType, List>* newNode = static_cast<DualLinkNode<UnderLyingType, List>*>(node);
+				Y_ASSERT(newNode->m_previous == newNode); // lists of a same link type share the node, it must be free
+				newNode->m_previous = nullptr;
+				newNode->m_next = m_first;
+				if (m_first != nullptr)
+					m_first->m_previous = newNode;
+				m_first = newNode;
+#ifdef KDEBUG
+				newNode->m_owner = this;
+#endif
+			}
+			
+			/*unlink node in place, return false if node is not linked or is the head of another list*/
+			bool remove(UnderLyingType* node)
+			{
+				if (!DualLinkNode<UnderLyingType, List>::isLinked(node))
+					return false;
+				DualLinkNode<UnderLyingType, List>* toRemove = static_cast<DualLinkNode<UnderLyingType, List>*>(node);
+#ifdef KDEBUG
+				Y_ASSERT(toRemove->m_owner == this);
+#endif
+				if (toRemove->m_previous == nullptr && m_first != toRemove)
+					return false;
+				if (toRemove->m_previous != nullptr)
+					toRemove->m_previous->m_next = toRemove->m_next;
+				else
+					m_first = toRemove->m_next;
+				if (toRemove->m_next != nullptr)
+					toRemove->m_next->m_previous = toRemove->m_previous;
+				toRemove->m_next = nullptr;
+				toRemove->m_previous = toRemove;
+#ifdef KDEBUG
+				toRemove->m_owner = nullptr;
+#endif
+				return true;
+			}
+			
+			bool isEmpty()
+			{
+				return m_first == nullptr;
+			}
+			
+			UnderLyingType* peekFirst()
+			{
+				return static_cast<UnderLyingType*>(m_first);
+			}
+		};
 }
@@ -0,0 +1,143 @@
+/*MIT License
+
+Copyright (c) 2019 Florian GERARD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Except as contained in this notice, the name of Florian GERARD shall not be used 
+in advertising or otherwise to promote the sale, use or other dealings in this 
+Software without prior written authorization from Florian GERARD
+
+*/
+
+#pragma once
+
+#include <cstdint>
+
+
+namespace framework
+{
+	/* Histogram of 32 bits values with bounded relative error, for latency measurements
+	 * values below 2^SubBits are counted exactly, above that each power of two is split in 2^SubBits buckets,
+	 * so a bucket is at most 1/2^SubBits of its values wide (25 % with default) */
+	template<uint32_t SubBits = 2>
+	class Histogram
+	{
+		static_assert(SubBits >= 1 && SubBits <= 8, "sub bucket bits must be in [1, 8]");
+	public:
+		static constexpr uint32_t subBuckets = 1u << SubBits;
+		static constexpr uint32_t bucketCount = (32 - SubBits + 1) * subBuckets;
+
+		constexpr Histogram() : m_buckets(), m_count(0), m_minimum(UINT32_MAX), m_maximum(0), m_total(0)
+		{
+		}
+
+		void record(uint32_t value)
+		{
+			uint32_t &bucket = m_buckets[bucketOf(value)];
+			if (bucket != UINT32_MAX) // saturate, a full bucket still orders percentiles
+				bucket++;
+			if (m_count != UINT32_MAX)
+				m_count++;
+			m_total += value;
+			if (value < m_minimum)
+				m_minimum = value;
+			if (value > m_maximum)
+				m_maximum = value;
+		}
+
+		void reset()
+		{
+			for (uint32_t i = 0; i < bucketCount; i++)
+				m_buckets[i] = 0;
+			m_count = 0;
+			m_minimum = UINT32_MAX;
+			m_maximum = 0;
+			m_total = 0;
+		}
+
+		uint32_t count() const
+		{
+			return m_count;
+		}
+
+		uint32_t minimum() const
+		{
+			return (m_count != 0) ? m_minimum : 0;
+		}
+
+		uint32_t maximum() const
+		{
+			return m_maximum;
+		}
+
+		uint32_t mean() const
+		{
+			return (m_count != 0) ? static_cast<uint32_t>(m_total / m_count) : 0;
+		}
+
+		/* value under which perMille thousandths of records are, rounded up to bucket upper bound
+		 * return 0 if nothing was recorded*/
+		uint32_t percentile(uint32_t perMille) const
+		{
+			if (m_count == 0)
+				return 0;
+			uint64_t rank = (static_cast<uint64_t>(m_count) * perMille + 999) / 1000;
+			if (rank == 0)
+				rank = 1;
+			uint64_t seen = 0;
+			for (uint32_t i = 0; i < bucketCount; i++)
+			{
+				seen += m_buckets[i];
+				if (seen >= rank)
+				{
+					uint32_t bound = upperBound(i);
+					return (bound < m_maximum) ? bound : m_maximum;
+				}
+			}
+			return m_maximum;
+		}
+
+	private:
+		uint32_t m_buckets[bucketCount];
+		uint32_t m_count;
+		uint32_t m_minimum;
+		uint32_t m_maximum;
+		uint64_t m_total;
+
+		static uint32_t bucketOf(uint32_t value)
+		{
+			if (value < subBuckets)
+				return value;
+			uint32_t shift = (31 - __builtin_clz(value)) - SubBits; // keep SubBits bits after leading one
+			return (shift + 1) * subBuckets + ((value >> shift) & (subBuckets - 1));
+		}
+
+		// largest value counted in bucket
+		static uint32_t upperBound(uint32_t bucket)
+		{
+			if (bucket < subBuckets)
+				return bucket;
+			uint32_t shift = bucket / subBuckets - 1;
+			uint64_t mantissa = subBuckets + bucket % subBuckets; // leading one restored
+			uint64_t bound = ((mantissa + 1) << shift) - 1;
+			return (bound > UINT32_MAX) ? UINT32_MAX : static_cast<uint32_t>(bound);
+		}
+	};
+} // namespace framework
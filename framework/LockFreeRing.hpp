@@ -0,0 +1,103 @@
+/*MIT License
+
+Copyright (c) 2019 Florian GERARD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Except as contained in this notice, the name of Florian GERARD shall not be used 
+in advertising or otherwise to promote the sale, use or other dealings in this 
+Software without prior written authorization from Florian GERARD
+
+*/
+
+#pragma once
+
+#include <cstdint>
+
+
+namespace framework
+{
+	/* Bounded ring with several producers and a single consumer, without lock
+	 * producers may preempt each other (nested interrupts) and the consumer, the consumer never preempts itself
+	 * each cell holds a sequence number: equal to position when free for producer, position + 1 when filled */
+	template<typename T, uint32_t Size>
+	class LockFreeRing
+	{
+		static_assert(Size != 0 && (Size & (Size - 1)) == 0, "ring size must be a power of 2");
+	public:
+		constexpr LockFreeRing() : m_cells(), m_head(0), m_tail(0)
+		{
+			for (uint32_t i = 0; i < Size; i++)
+				m_cells[i].sequence = i;
+		}
+
+		// add an item, return false if ring is full
+		bool push(const T &item)
+		{
+			uint32_t position = __atomic_load_n(&m_head, __ATOMIC_RELAXED);
+			while (true)
+			{
+				Cell &cell = m_cells[position & (Size - 1)];
+				int32_t difference = static_cast<int32_t>(__atomic_load_n(&cell.sequence, __ATOMIC_ACQUIRE) - position);
+				if (difference == 0)
+				{
+					//claim the cell, on failure position is reloaded with current head
+					if (__atomic_compare_exchange_n(&m_head, &position, position + 1, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+					{
+						cell.item = item;
+						__atomic_store_n(&cell.sequence, position + 1, __ATOMIC_RELEASE);
+						return true;
+					}
+				}
+				else if (difference < 0) //cell not consumed yet, ring is full
+					return false;
+				else //another producer claimed this cell
+					position = __atomic_load_n(&m_head, __ATOMIC_RELAXED);
+			}
+		}
+
+		// remove oldest item, return false if ring is empty or oldest item is still being written
+		bool pop(T &item)
+		{
+			Cell &cell = m_cells[m_tail & (Size - 1)];
+			if (__atomic_load_n(&cell.sequence, __ATOMIC_ACQUIRE) != m_tail + 1)
+				return false;
+			item = cell.item;
+			__atomic_store_n(&cell.sequence, m_tail + Size, __ATOMIC_RELEASE);
+			m_tail++;
+			return true;
+		}
+
+		bool isEmpty()
+		{
+			return __atomic_load_n(&m_cells[m_tail & (Size - 1)].sequence, __ATOMIC_ACQUIRE) != m_tail + 1;
+		}
+
+	private:
+		struct Cell
+		{
+			uint32_t sequence;
+			T item;
+		};
+
+		Cell m_cells[Size];
+		uint32_t m_head; // next position claimed by producers
+		uint32_t m_tail; // next position read by consumer
+	};
+} // namespace framework
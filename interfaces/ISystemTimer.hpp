@@ -41,6 +41,42 @@ namespace core
 			virtual void initSystemTimer(uint32_t coreFrequency, uint32_t ticksFrequency) = 0;
 			virtual void startSystemTimer() = 0;
 			virtual Irq getIrq() =0;
+
+			/* Tickless idle support, used by kernel when built with KERNEL_TICKLESS
+			 * a timer without one shot support keeps these defaults and the kernel keeps ticking */
+
+			// longest period a one shot can last, in ticks, 0 if one shot is not supported
+			virtual uint32_t maxOneShotTicks()
+			{
+				return 0;
+			}
+
+			// stop periodic ticks and raise next tick interrupt in ticks periods
+			virtual void startOneShot(uint32_t ticks)
+			{
+			}
+
+			// go back to periodic ticks, keeping phase with the elapsed part of current period
+			//@return number of whole periods elapsed since startOneShot, without the one reported by a pending tick interrupt
+			virtual uint32_t stopOneShot()
+			{
+				return 0;
+			}
+
+			/* Sub tick time support, used by kernel cycle clock
+			 * a timer keeping these defaults gives a cycle clock with one tick resolution */
+
+			// core cycles elapsed since last tick period started (SysTick reload value minus current value for instance)
+			virtual uint32_t cyclesSinceTick()
+			{
+				return 0;
+			}
+
+			// true if a period ended but its tick interrupt is not handled yet, must not clear anything when read
+			virtual bool isTickPending()
+			{
+				return false;
+			}
 		};
 	}	//End namespace interfaces
 }//End namespace core
\ No newline at end of file
@@ -55,12 +55,23 @@ namespace kernel
 			return Scheduler::startKernel();
 		}
 		
-		/*wait without using kernel
-		 *@Warning : will wait until time counter elapsed*/
+		/*wait without using kernel, busy loop on cycle clock
+		 *resolution is a tick if system timer does not report cycles since last tick
+		 *@Warning : will wait until time counter elapsed, kernel must be started*/
+		static void waitCycles(uint64_t cycles)
+		{
+			uint64_t endWaitTimeStamp = Scheduler::getCycles() + cycles;
+			while (Scheduler::getCycles() < endWaitTimeStamp) ;
+		}
+
 		static void wait(uint32_t ms)
 		{
-			uint64_t endWaitTimeStamp = Scheduler::s_ticks + ms;
-			while (Scheduler::s_ticks <= endWaitTimeStamp) ;
+			waitCycles(static_cast<uint64_t>(ms) * Scheduler::s_coreFrequency / 1000);
+		}
+
+		static void waitMicroseconds(uint32_t us)
+		{
+			waitCycles(static_cast<uint64_t>(us) * Scheduler::s_coreFrequency / 1000000);
 		}
 		
 		/*set a Task into sleep for an amount of ms
@@ -77,10 +88,56 @@ namespace kernel
 
 		
 
-		/*get kernel timeStamp*/
+		/*set a Task into sleep until kernel time stamp reaches tick, release times do not drift with task execution time
+		 *return false without sleeping if tick is already reached
+		 *@Warning: do not call it if you're not in a Task*/
+		static inline bool sleepUntil(uint64_t tick)
+		{
+			Y_ASSERT(Scheduler::inThreadMode());
+			return sleepUntilKernel(static_cast<uint32_t>(tick), static_cast<uint32_t>(tick >> 32));
+		}
+
+		/*give processor to the next ready task of same priority, return false without switching if there is none
+		 *@Warning: do not call it if you're not in a Task*/
+		const static inline auto &yield = core::Core::supervisorCall<ServiceCall::SvcNumber::yieldTask, bool>;
+
+		/*wait for a notification of the calling task, value receives the notification value
+		 *return 1 if success, -1 if timeout
+		 *@Warning: do not call it if you're not in a Task*/
+		static inline int16_t waitNotification(uint32_t &value, uint32_t timeout = 0, bool clearOnExit = true)
+		{
+			return Notification::wait(value, timeout, clearOnExit);
+		}
+
+		/*set round robin quantum of a priority level, in ticks, 0 disables time slicing for the level
+		 *takes effect on next quantum, a task holding a CeilingMutex rotates once it releases it*/
+		static inline void setTimeSlice(uint32_t priority, uint32_t ticks)
+		{
+			Y_ASSERT(priority < config::priorityLevels);
+			Scheduler::s_timeSlices[priority] = ticks;
+		}
+
+		/*get kernel timeStamp, safe from any context*/
 		static inline uint64_t getTicks()
 		{
-			return Scheduler::s_ticks;
+			return Scheduler::getTicks();
+		}
+
+		/*get monotonic core cycles count since kernel time origin, safe from any context*/
+		static inline uint64_t getCycles()
+		{
+			return Scheduler::getCycles();
+		}
+
+		/*get monotonic time in nanoseconds, from cycle clock scaled by core frequency*/
+		static inline uint64_t getNanoseconds()
+		{
+			if (Scheduler::s_coreFrequency == 0) // kernel not started
+				return 0;
+			uint64_t cycles = Scheduler::getCycles();
+			uint64_t seconds = cycles / Scheduler::s_coreFrequency;
+			uint64_t remainder = cycles % Scheduler::s_coreFrequency; // split to keep product in 64 bits
+			return seconds * 1000000000ULL + remainder * 1000000000ULL / Scheduler::s_coreFrequency;
 		}
 		
 		/*register an irq before the scheduler has started*/
@@ -163,6 +220,13 @@ namespace kernel
 		/*Unlock Interrupts*/
 		static const inline auto& exitCriticalSection = core::Core::supervisorCall<ServiceCall::SvcNumber::exitCriticalSection, void>;
 	private:
+		// sleep until an absolute tick given as two words, service call arguments are 32 bits
+		//@return false if tick is already reached
+		//@params low word of tick, high word of tick
+
+		static const inline auto& sleepUntilKernel =
+			core::Core::supervisorCall<ServiceCall::SvcNumber::sleepUntilTask, bool, uint32_t, uint32_t>;
+
 		/* Register an interrupt */
 		//@return true if success, false otherwise
 		//@params irq to register, irqHandler to use when irq is triggered, const char* name of irq
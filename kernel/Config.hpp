@@ -0,0 +1,114 @@
+/*MIT License
+
+Copyright (c) 2019 Florian GERARD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Except as contained in this notice, the name of Florian GERARD shall not be used 
+in advertising or otherwise to promote the sale, use or other dealings in this 
+Software without prior written authorization from Florian GERARD
+
+*/
+
+#pragma once
+
+#include <cstdint>
+
+/* Kernel compile time configuration
+ * every value can be overridden by defining the macro before including the kernel (or from the compiler command line) */
+
+#ifndef KERNEL_PRIORITY_LEVELS
+#define KERNEL_PRIORITY_LEVELS 32
+#endif
+
+#ifndef KERNEL_TIMER_WHEEL_SLOTS
+#define KERNEL_TIMER_WHEEL_SLOTS 64
+#endif
+
+#ifndef KERNEL_TIME_SLICE
+#define KERNEL_TIME_SLICE 0
+#endif
+
+// start kernel time at a given tick, set it close to a word boundary (0xFFFFF000 for instance) to exercise long uptimes quickly
+#ifndef KERNEL_INITIAL_TICKS
+#define KERNEL_INITIAL_TICKS 0
+#endif
+
+#ifndef KERNEL_TRACE_RECORDS
+#define KERNEL_TRACE_RECORDS 256
+#endif
+
+#ifndef KERNEL_ISR_REQUEST_SLOTS
+#define KERNEL_ISR_REQUEST_SLOTS 16
+#endif
+
+// define KERNEL_TICKLESS to stop the periodic tick while only idle task can run
+// define KERNEL_RUNTIME_STATS to measure processor time of each task (see RuntimeStats.hpp)
+// define KERNEL_TRACE to record kernel events in a RAM ring buffer (see Trace.hpp)
+// define KERNEL_LATENCY_PROBES to measure kernel latencies in cycle histograms (see LatencyProbes.hpp)
+// define KERNEL_CHECK_INVARIANTS to verify scheduler lists and task states on each task switch (needs KDEBUG, cost grows with task count)
+#if defined(KERNEL_CHECK_INVARIANTS) && !defined(KDEBUG)
+#error "KERNEL_CHECK_INVARIANTS reports failures through Y_ASSERT, define KDEBUG"
+#endif
+// started tasks are only listed for the options walking every task, other builds save the links in each task
+#if defined(KERNEL_RUNTIME_STATS) || defined(KERNEL_CHECK_INVARIANTS)
+#define KERNEL_STARTED_LIST
+#endif
+#ifndef KERNEL_TICKLESS_MIN_IDLE_TICKS
+#define KERNEL_TICKLESS_MIN_IDLE_TICKS 2
+#endif
+
+namespace kernel
+{
+	namespace config
+	{
+		/* Number of task priority levels, a task priority must be in [0, priorityLevels - 1]
+		 * higher number means higher priority, 0 is reserved for idle task */
+		constexpr uint32_t priorityLevels = KERNEL_PRIORITY_LEVELS;
+		static_assert(priorityLevels > 1 && priorityLevels <= 32, "priority levels must fit in a 32 bits ready bitmap");
+
+		/* Number of slots of the timeout wheel, a timeout lands in slot (wake up tick % timerWheelSlots)
+		 * should be a bit larger than the usual number of pending timeouts to keep slots short */
+		constexpr uint32_t timerWheelSlots = KERNEL_TIMER_WHEEL_SLOTS;
+		static_assert(timerWheelSlots != 0 && (timerWheelSlots & (timerWheelSlots - 1)) == 0, "timer wheel slots must be a power of 2");
+
+		/* Default round robin quantum, in ticks, of every priority level, 0 disables time slicing
+		 * can be changed per level at run time with Api::setTimeSlice */
+		constexpr uint32_t defaultTimeSlice = KERNEL_TIME_SLICE;
+
+		/* Shortest idle period, in ticks, for which tickless idle reprograms the system timer
+		 * shorter periods just wait for next tick */
+		constexpr uint32_t ticklessMinIdleTicks = KERNEL_TICKLESS_MIN_IDLE_TICKS;
+		static_assert(ticklessMinIdleTicks >= 2, "a one shot shorter than 2 ticks does not suppress any tick");
+
+		/* Number of kernel requests interrupts can post before the context switch interrupt applies them
+		 * a request posted while all slots are pending is rejected */
+		constexpr uint32_t isrRequestSlots = KERNEL_ISR_REQUEST_SLOTS;
+		static_assert(isrRequestSlots != 0 && (isrRequestSlots & (isrRequestSlots - 1)) == 0, "isr request slots must be a power of 2");
+
+		/* Number of records kept by kernel trace, 12 bytes each, only used when KERNEL_TRACE is defined*/
+		constexpr uint32_t traceRecords = KERNEL_TRACE_RECORDS;
+		static_assert(traceRecords != 0 && (traceRecords & (traceRecords - 1)) == 0, "trace records must be a power of 2");
+
+		/* Kernel time at start, in ticks, 0 unless testing long uptimes
+		 * every kernel time stamp is 64 bits wide so no value wraps during device lifetime */
+		constexpr uint64_t initialTicks = KERNEL_INITIAL_TICKS;
+
+	} // namespace config
+} // namespace kernel
@@ -30,6 +30,7 @@ Software without prior written authorization from Florian GERARD
 #include "Scheduler.hpp"
 #include "core/Core.hpp"
 #include "Hooks.hpp"
+#include "IsrRequests.hpp"
 
 namespace kernel
 {
@@ -38,23 +39,37 @@ namespace kernel
 	{
 		Y_ASSERT(event != nullptr);
 		kernel::Hooks::onEventTrigger(event);
-		if (event->m_waiter != nullptr)
+		if (event->m_mode == Mode::manualReset)
 		{
-			TaskController* newReadyTask = event->m_waiter;
-			event->m_waiter = nullptr;
-			Y_ASSERT(!Scheduler::s_ready.contain(newReadyTask)); //If the event ready task is already in ready list, we have a problem
-			newReadyTask->m_waitingFor = nullptr;
-			event->stopWait(newReadyTask);
-			Y_ASSERT(!Scheduler::s_waiting.contain(newReadyTask)); 
-			Scheduler::s_ready.insert(newReadyTask, TaskController::priorityCompare);
-			newReadyTask->m_state = kernel::TaskController::State::ready;
-			kernel::Hooks::onTaskReady(newReadyTask);
+			event->m_isRaised = true;
+			if (!event->m_waiting.isEmpty())
+			{
+				while (!event->m_waiting.isEmpty()) // broadcast
+					event->releaseFirst();
+				Scheduler::schedule(kernel::Scheduler::changeTaskTrigger::wakeByEvent);
+			}
+		}
+		else if (!event->m_waiting.isEmpty())
+		{
+			event->releaseFirst();
 			Scheduler::schedule(kernel::Scheduler::changeTaskTrigger::wakeByEvent);
 		}
 		else
 			event->m_isRaised = true;
 		return true;
 	}
+
+	void Event::releaseFirst()
+	{
+		TaskController* newReadyTask = m_waiting.getFirst();
+		Y_ASSERT(!Scheduler::s_ready.contain(newReadyTask)); //If the event ready task is already in ready list, we have a problem
+		newReadyTask->m_waitingFor = nullptr;
+		stopWait(newReadyTask);
+		Y_ASSERT(!Scheduler::s_timers.contain(newReadyTask)); 
+		Scheduler::s_ready.insert(newReadyTask);
+		newReadyTask->m_state = kernel::TaskController::State::ready;
+		kernel::Hooks::onTaskReady(newReadyTask);
+	}
 		
 		
 	//A task ask to wait for an event
@@ -63,21 +78,22 @@ namespace kernel
 	{
 		if (event->m_isRaised)	//event already rised, return
 		{
-			event->m_isRaised = false;
+			if (event->m_mode == Mode::autoReset)
+				event->m_isRaised = false;
 			return 1;
 		}
 		else	//add task at the end of the waiting list
 		{
 
-			if (event->m_waiter != nullptr)
+			if (event->m_mode == Mode::autoReset && !event->m_waiting.isEmpty())
 				return 0;
 			//no need to lock as we are in SVC so nothing should interrupt and write this
 			Y_ASSERT(Scheduler::s_activeTask != nullptr);
-			event->m_waiter = Scheduler::s_activeTask; //insert active task into event waiting list
+			event->m_waiting.insert(Scheduler::s_activeTask, TaskController::priorityCompare); //insert active task into event waiting list
 			if (duration > 0)
 			{
 				Scheduler::s_activeTask->m_wakeUpTimeStamp = Scheduler::s_ticks + duration;
-				Scheduler::s_waiting.insert(Scheduler::s_activeTask, TaskController::sleepCompare);
+				Scheduler::s_timers.insert(Scheduler::s_activeTask, Scheduler::s_ticks);
 			}
 			Scheduler::s_activeTask->m_waitingFor = event;
 			Scheduler::s_activeTask->m_state = TaskController::State::waitingEvent;		   //sets active task as waiting
@@ -101,12 +117,14 @@ namespace kernel
 		return true;
 	}
 		
+	bool Event::signalFromIsr()
+	{
+		return IsrRequests::post(IsrRequests::Type::signalEvent, this);
+	}
+
 	bool Event::someoneWaiting()
 	{
-		if (m_waiter != nullptr)
-			return true;
-		else
-			return false;
+		return !m_waiting.isEmpty();
 	}
 	
 	void Event::reset()
@@ -121,23 +139,20 @@ namespace kernel
 
 	void Event::stopWait(TaskController* task)
 	{
-		if (task->m_wakeUpTimeStamp != 0)
-		{
-			Scheduler::s_waiting.remove(task);
+		if (Scheduler::s_timers.remove(task))
 			task->m_wakeUpTimeStamp = 0;
-		}
 		
 	}
 	void Event::onTimeout(TaskController* task)
 	{
 		Hooks::onEventTimeout(this);
-		Y_ASSERT(task == m_waiter);
 		Y_ASSERT(task != nullptr);
-		m_waiter = nullptr; // no more task waiting the event
+		Y_ASSERT(task->m_waitingFor == this);
+		m_waiting.remove(task); // no more waiting the event
 		task->m_waitingFor = nullptr; //the task is no more waiting for event
 		task->setReturnValue(static_cast<int16_t>(-1));
 		task->m_wakeUpTimeStamp = 0;
-		Scheduler::s_ready.insert(task, TaskController::priorityCompare);
+		Scheduler::s_ready.insert(task);
 		task->m_state = kernel::TaskController::State::ready;
 		Hooks::onTaskReady(task);
 		Scheduler::schedule(kernel::Scheduler::changeTaskTrigger::wakeByEvent);
@@ -43,7 +43,13 @@ namespace kernel
 		friend class Scheduler; //let Scheduler access private function but no one else
 	public:
 		
-		constexpr Event(bool isRaised = false, const char*name = nullptr) :m_waiter(nullptr), m_isRaised(isRaised), m_name(name)
+		enum class Mode : uint8_t
+		{
+			autoReset, // one waiter, a signal releases it or stays raised until next wait
+			manualReset, // any number of waiters, a signal releases all of them and stays raised until reset
+		};
+
+		constexpr Event(bool isRaised = false, const char*name = nullptr, Mode mode = Mode::autoReset) :m_waiting(), m_isRaised(isRaised), m_mode(mode), m_name(name)
 		{
 		}
 		
@@ -63,13 +69,19 @@ namespace kernel
 		//@parameter Task waiting for the event
 		//return true if the task is waiting,
 		//false if event is already rised
+		//an auto reset event refuses a second waiter (return 0), a manual reset one stays raised until reset
 		int16_t wait(uint32_t duration = 0);
 		
 		
 		//Signal that an event occured
 		//if a task is already waiting then return it to wake it up
 		//else rise event and return nullptr
+		//a manual reset event stays raised and releases all waiters, highest priority first, with one scheduling pass
 		bool signal();
+
+		//Signal an event from an interrupt handler, applied by kernel once interrupts are done
+		//return false if too many interrupt requests are pending
+		bool signalFromIsr();
 		
 		bool someoneWaiting();
 
@@ -83,10 +95,14 @@ namespace kernel
 	  private:
 		
 		//------------------PRIVATE DATA------------------------
-		TaskController* volatile m_waiter;
+		EventList m_waiting; // ordered by priority, at most one task in auto reset mode
 		bool m_isRaised;
+		const Mode m_mode;
 		const char *m_name;
 
+		// make first waiter ready
+		void releaseFirst();
+
 		//------------------PRIVATE FUNCTIONS---------------------
 		
 		using SupervisorEventWait = int16_t(&)(Event*, uint32_t);
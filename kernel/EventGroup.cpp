@@ -0,0 +1,172 @@
+/*MIT License
+
+Copyright (c) 2019 Florian GERARD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Except as contained in this notice, the name of Florian GERARD shall not be used 
+in advertising or otherwise to promote the sale, use or other dealings in this 
+Software without prior written authorization from Florian GERARD
+
+*/
+
+#include "EventGroup.hpp"
+#include "Hooks.hpp"
+#include "IsrRequests.hpp"
+#include "Scheduler.hpp"
+#include "core/Core.hpp"
+
+
+namespace kernel
+{
+	uint32_t EventGroup::waitAny(uint32_t mask, bool clearOnExit, uint32_t timeout)
+	{
+		return wait(mask, clearOnExit ? clearOnExitOption : 0, timeout);
+	}
+
+	uint32_t EventGroup::waitAll(uint32_t mask, bool clearOnExit, uint32_t timeout)
+	{
+		return wait(mask, waitAllOption | (clearOnExit ? clearOnExitOption : 0), timeout);
+	}
+
+	uint32_t EventGroup::wait(uint32_t mask, uint32_t options, uint32_t timeout)
+	{
+		Y_ASSERT(Scheduler::inThreadMode());
+		Y_ASSERT(mask != 0);
+		return supervisorCallWaitEventGroup(this, mask, options, timeout);
+	}
+
+	bool EventGroup::set(uint32_t mask)
+	{
+		return supervisorCallSetEventGroup(this, mask);
+	}
+
+	bool EventGroup::setFromIsr(uint32_t mask)
+	{
+		return IsrRequests::post(IsrRequests::Type::setEventGroup, this, mask);
+	}
+
+	uint32_t EventGroup::clear(uint32_t mask)
+	{
+		return __atomic_fetch_and(&m_flags, ~mask, __ATOMIC_ACQ_REL);
+	}
+
+	uint32_t EventGroup::get()
+	{
+		return m_flags;
+	}
+
+	bool EventGroup::someoneWaiting()
+	{
+		return !m_waiting.isEmpty();
+	}
+
+	bool EventGroup::isSatisfied(uint32_t flags, uint32_t mask, uint32_t options)
+	{
+		if (options & waitAllOption)
+			return (flags & mask) == mask;
+		return (flags & mask) != 0;
+	}
+
+	// A task wait for flags, return immediately if they are already set
+	uint32_t EventGroup::kernelWaitEventGroup(EventGroup *group, uint32_t mask, uint32_t options, uint32_t duration)
+	{
+		Y_ASSERT(Scheduler::s_activeTask != nullptr);
+		uint32_t flags = group->m_flags;
+		if (isSatisfied(flags, mask, options))
+		{
+			if (options & clearOnExitOption)
+				__atomic_fetch_and(&group->m_flags, ~mask, __ATOMIC_ACQ_REL);
+			return flags;
+		}
+		Scheduler::s_activeTask->m_waitValue = mask;
+		Scheduler::s_activeTask->m_waitOptions = static_cast<uint8_t>(options);
+		group->m_waiting.insert(Scheduler::s_activeTask, TaskController::priorityCompare);
+		if (duration > 0)
+		{
+			Scheduler::s_activeTask->m_wakeUpTimeStamp = Scheduler::s_ticks + duration;
+			Scheduler::s_timers.insert(Scheduler::s_activeTask, Scheduler::s_ticks);
+		}
+		Scheduler::s_activeTask->m_waitingFor = group;
+		Scheduler::s_activeTask->m_state = kernel::TaskController::State::waitingEventGroup;
+		Scheduler::s_taskToStack = Scheduler::s_activeTask;
+		Scheduler::s_activeTask = Scheduler::s_ready.getFirst();
+		Hooks::onEventGroupWait(group, Scheduler::s_taskToStack, duration);
+		Scheduler::setPendSv(kernel::Scheduler::changeTaskTrigger::waitForEventGroup);
+		return 0; // overwritten with satisfying flags by the task setting them
+	}
+
+	// every waiter is evaluated against the same flags, flags asked to be cleared are cleared once all are served
+	bool EventGroup::kernelSetEventGroup(EventGroup *group, uint32_t mask)
+	{
+		Y_ASSERT(group != nullptr);
+		Hooks::onEventGroupSet(group, mask);
+		uint32_t flags = __atomic_or_fetch(&group->m_flags, mask, __ATOMIC_ACQ_REL);
+		uint32_t toClear = 0;
+		bool woken = false;
+		TaskController *waiter = group->m_waiting.peekFirst();
+		while (waiter != nullptr)
+		{
+			TaskController *following = framework::DualLinkNode<TaskController, StateLink>::next(waiter);
+			if (isSatisfied(flags, waiter->m_waitValue, waiter->m_waitOptions))
+			{
+				group->m_waiting.remove(waiter);
+				Y_ASSERT(!Scheduler::s_ready.contain(waiter)); //If the waiter is already in ready list, we have a problem
+				if (waiter->m_waitOptions & clearOnExitOption)
+					toClear |= waiter->m_waitValue;
+				waiter->m_waitingFor = nullptr;
+				group->stopWait(waiter);
+				waiter->setReturnValue(flags);
+				Scheduler::s_ready.insert(waiter);
+				waiter->m_state = kernel::TaskController::State::ready;
+				Hooks::onTaskReady(waiter);
+				woken = true;
+			}
+			waiter = following;
+		}
+		if (toClear != 0)
+			__atomic_fetch_and(&group->m_flags, ~toClear, __ATOMIC_ACQ_REL);
+		if (woken)
+			Scheduler::schedule(kernel::Scheduler::changeTaskTrigger::wakeByEventGroup);
+		return true;
+	}
+
+	void EventGroup::stopWait(TaskController *task)
+	{
+		if (Scheduler::s_timers.remove(task))
+			task->m_wakeUpTimeStamp = 0;
+	}
+
+	void EventGroup::onTimeout(TaskController *task)
+	{
+		Y_ASSERT(task->m_waitingFor == this);
+		m_waiting.remove(task);
+		task->m_waitingFor = nullptr; //the task is no more waiting for flags
+		task->setReturnValue(static_cast<uint32_t>(0)); // timeout code
+		task->m_wakeUpTimeStamp = 0;
+		Scheduler::s_ready.insert(task);
+		task->m_state = kernel::TaskController::State::ready;
+		Hooks::onEventGroupTimeout(this, task);
+		Hooks::onTaskReady(task);
+		Scheduler::schedule(kernel::Scheduler::changeTaskTrigger::eventGroupTimeout);
+	}
+
+	EventGroup::SupervisorCallWaitEventGroup EventGroup::supervisorCallWaitEventGroup = core::Core::supervisorCall<ServiceCall::SvcNumber::eventGroupWait, uint32_t, EventGroup*, uint32_t, uint32_t, uint32_t>;
+	EventGroup::SupervisorCallSetEventGroup EventGroup::supervisorCallSetEventGroup = core::Core::supervisorCall<ServiceCall::SvcNumber::eventGroupSet, bool, EventGroup*, uint32_t>;
+} // End namespace kernel
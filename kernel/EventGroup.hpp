@@ -0,0 +1,106 @@
+/*MIT License
+
+Copyright (c) 2019 Florian GERARD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Except as contained in this notice, the name of Florian GERARD shall not be used 
+in advertising or otherwise to promote the sale, use or other dealings in this 
+Software without prior written authorization from Florian GERARD
+
+*/
+
+#pragma once
+
+#include <cstdint>
+
+#include "Task.hpp"
+#include "ServiceCall.hpp"
+#include "yggdrasil/interfaces/IWaitable.hpp"
+
+
+namespace kernel
+{
+	/* Group of 32 event flags
+	 * any number of tasks wait for any or all flags of a mask, a single set wakes every satisfied waiter
+	 * flags stay set until cleared, explicitly or by a waiter asking to clear its mask on exit */
+	class EventGroup : public interfaces::IWaitable
+	{
+		friend class Scheduler;
+		friend class IsrRequests;
+	public:
+
+		constexpr EventGroup(uint32_t initialFlags = 0, const char *name = nullptr) : m_waiting(), m_flags(initialFlags), m_name(name)
+		{
+		}
+
+		/* wait for at least one flag of mask
+		 * -clearOnExit clear flags of mask once satisfied
+		 * -timeout specify a time in ms to wait, 0 for no timeout
+		 * return flags that satisfied the wait (before clearing), 0 if timeout*/
+		uint32_t waitAny(uint32_t mask, bool clearOnExit = false, uint32_t timeout = 0);
+
+		/* wait for every flag of mask
+		 * return flags that satisfied the wait (before clearing), 0 if timeout*/
+		uint32_t waitAll(uint32_t mask, bool clearOnExit = false, uint32_t timeout = 0);
+
+		// set flags of mask, wake every satisfied waiter with one scheduling pass
+		bool set(uint32_t mask);
+
+		// set flags from an interrupt handler, return false if too many interrupt requests are pending
+		bool setFromIsr(uint32_t mask);
+
+		// clear flags of mask, return flags before clearing
+		uint32_t clear(uint32_t mask);
+
+		uint32_t get();
+
+		bool someoneWaiting();
+
+	private:
+		// wait options stored in waiting task
+		static constexpr uint32_t waitAllOption = 1 << 0;
+		static constexpr uint32_t clearOnExitOption = 1 << 1;
+		static_assert((waitAllOption | clearOnExitOption) < (1 << 7), "task keeps wait options in 7 bits");
+
+		EventList m_waiting;
+		volatile uint32_t m_flags; // updated atomically, interrupts and tasks may clear flags while kernel sets them
+		const char *m_name;
+
+		uint32_t wait(uint32_t mask, uint32_t options, uint32_t timeout);
+		static bool isSatisfied(uint32_t flags, uint32_t mask, uint32_t options);
+
+		static uint32_t kernelWaitEventGroup(EventGroup *group, uint32_t mask, uint32_t options, uint32_t duration);
+		static bool kernelSetEventGroup(EventGroup *group, uint32_t mask);
+		void stopWait(TaskController *task) final;
+		void onTimeout(TaskController *task) final;
+
+		// call kernel to wait for flags
+		//@return uint32_t, flags satisfying the wait, 0 if timeout
+		//@params pointer to group, mask, options, optional timeout (0 to disable)
+		using SupervisorCallWaitEventGroup = uint32_t(&)(EventGroup*, uint32_t, uint32_t, uint32_t);
+		static SupervisorCallWaitEventGroup& supervisorCallWaitEventGroup;
+
+		// call kernel to set flags
+		//@return bool, always true
+		//@params pointer to group, mask
+		using SupervisorCallSetEventGroup = bool(&)(EventGroup*, uint32_t);
+		static SupervisorCallSetEventGroup& supervisorCallSetEventGroup;
+	};
+} // namespace kernel
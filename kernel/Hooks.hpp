@@ -1,7 +1,13 @@
 #pragma once
 #include "yggdrasil/kernel/Event.hpp"
 #include "yggdrasil/kernel/Mutex.hpp"
+#include "yggdrasil/kernel/Semaphore.hpp"
+#include "yggdrasil/kernel/MessageQueue.hpp"
+#include "yggdrasil/kernel/EventGroup.hpp"
+#include "yggdrasil/kernel/Notification.hpp"
 #include "yggdrasil/kernel/Task.hpp"
+#include "yggdrasil/kernel/Trace.hpp"
+#include "yggdrasil/kernel/LatencyProbes.hpp"
 #include "yggdrasil/interfaces/IWaitable.hpp"
 
 namespace kernel
@@ -11,86 +17,211 @@ namespace kernel
 	  public:
 		static void onKernelStart()
 		{
-#ifdef SYSVIEW
-			kernel::SystemView::get().start();
+#ifdef KERNEL_TRACE
+			Trace::onKernelStart();
 #endif
 		}
 		
 		
 		static void onTaskStart(TaskController *task)
 		{
-#ifdef SYSVIEW
-			kernel::SystemView::get().sendTaskInfo(&task);
-			kernel::SystemView::get().onTaskCreate(&task);
-			kernel::SystemView::get().onTaskStartReady(&task);
+#ifdef KERNEL_TRACE
+			Trace::onTaskStart(task);
+			Trace::record(TraceEvent::taskReady, task);
 #endif
 		}
 
 		static void onTaskStartExec(TaskController *task)
 		{
-#ifdef SYSVIEW
-			SystemView::get().onTaskStartExec(s_activeTask);
+#ifdef KERNEL_TRACE
+			Trace::record(TraceEvent::taskStartExec, task);
+#endif
+#ifdef KERNEL_LATENCY_PROBES
+			LatencyProbes::onTaskStartExec(task);
 #endif
 		}
 
 		static void onTaskStopExec(TaskController *task)
 		{
-			
+#ifdef KERNEL_TRACE
+			Trace::record(TraceEvent::taskStopExec, task);
+#endif
 		}
 
 		static void onTaskClose(TaskController *task)
 		{
-#ifdef SYSVIEW
-			SystemView::get().onTaskTerminate(&task);
+#ifdef KERNEL_TRACE
+			Trace::record(TraceEvent::taskClose, task);
 #endif
 		}
 
 		static void onTaskReady(TaskController *task)
 		{
-#ifdef SYSVIEW
-			kernel::SystemView::get().onTaskStartReady(s_taskToStack);
+#ifdef KERNEL_TRACE
+			Trace::record(TraceEvent::taskReady, task);
+#endif
+#ifdef KERNEL_LATENCY_PROBES
+			LatencyProbes::onTaskReady(task);
 #endif
 		}
 
 		static void onTaskSleep(TaskController *task, uint64_t time)
 		{
-#ifdef SYSVIEW
-			SystemView::get().onTaskStopReady(s_taskToStack, static_cast<uint8_t>(changeTaskTrigger::enterSleep));
+#ifdef KERNEL_TRACE
+			Trace::record(TraceEvent::taskSleep, task, static_cast<uint32_t>(time));
 #endif
 		}
 
 		static void onTaskWaitEvent(TaskController *task, Event *event)
 		{
-			
+#ifdef KERNEL_TRACE
+			Trace::record(TraceEvent::taskWaitEvent, task, static_cast<uint32_t>(reinterpret_cast<uintptr_t>(event)));
+#endif
 		}
 
 		static void onEventTrigger(Event *event)
 		{
-			
+#ifdef KERNEL_TRACE
+			Trace::record(TraceEvent::eventTrigger, event);
+#endif
 		}
 
 		static void onEventTimeout(Event *event)
 		{
-			
+#ifdef KERNEL_TRACE
+			Trace::record(TraceEvent::eventTimeout, event);
+#endif
 		}
 		
 		/* Mutex*/
 		static void onMutexLock(Mutex *mutex, TaskController* locker)
 		{
-			
+#ifdef KERNEL_TRACE
+			Trace::record(TraceEvent::mutexLock, locker, static_cast<uint32_t>(reinterpret_cast<uintptr_t>(mutex)));
+#endif
 		}
 
 		static void onMutexRelease(Mutex *mutex)
 		{
+#ifdef KERNEL_TRACE
+			Trace::record(TraceEvent::mutexRelease, mutex);
+#endif
 		}
 
 		static void onMutexWait(Mutex *mutex,TaskController* waiter, uint32_t timeout)
 		{
+#ifdef KERNEL_TRACE
+			Trace::record(TraceEvent::mutexWait, waiter, static_cast<uint32_t>(reinterpret_cast<uintptr_t>(mutex)));
+#endif
 		}
 
 		static void onMutexTimeout(Mutex *mutex, TaskController *task)
 		{
-			
+#ifdef KERNEL_TRACE
+			Trace::record(TraceEvent::mutexTimeout, task, static_cast<uint32_t>(reinterpret_cast<uintptr_t>(mutex)));
+#endif
+		}
+
+		/* Semaphore*/
+		static void onSemaphoreTake(Semaphore *semaphore, TaskController *taker)
+		{
+#ifdef KERNEL_TRACE
+			Trace::record(TraceEvent::semaphoreTake, taker, static_cast<uint32_t>(reinterpret_cast<uintptr_t>(semaphore)));
+#endif
+		}
+
+		static void onSemaphoreGive(Semaphore *semaphore, uint32_t units)
+		{
+#ifdef KERNEL_TRACE
+			Trace::record(TraceEvent::semaphoreGive, semaphore);
+#endif
+		}
+
+		static void onSemaphoreWait(Semaphore *semaphore, TaskController *waiter, uint32_t timeout)
+		{
+#ifdef KERNEL_TRACE
+			Trace::record(TraceEvent::semaphoreWait, waiter, static_cast<uint32_t>(reinterpret_cast<uintptr_t>(semaphore)));
+#endif
+		}
+
+		static void onSemaphoreTimeout(Semaphore *semaphore, TaskController *task)
+		{
+#ifdef KERNEL_TRACE
+			Trace::record(TraceEvent::semaphoreTimeout, task, static_cast<uint32_t>(reinterpret_cast<uintptr_t>(semaphore)));
+#endif
+		}
+
+		/* Message queue*/
+		static void onQueueSend(MessageQueueBase *queue)
+		{
+#ifdef KERNEL_TRACE
+			Trace::record(TraceEvent::queueSend, queue);
+#endif
+		}
+
+		static void onQueueReceive(MessageQueueBase *queue)
+		{
+#ifdef KERNEL_TRACE
+			Trace::record(TraceEvent::queueReceive, queue);
+#endif
+		}
+
+		static void onQueueWait(MessageQueueBase *queue, TaskController *waiter, uint32_t timeout)
+		{
+#ifdef KERNEL_TRACE
+			Trace::record(TraceEvent::queueWait, waiter, static_cast<uint32_t>(reinterpret_cast<uintptr_t>(queue)));
+#endif
+		}
+
+		static void onQueueTimeout(MessageQueueBase *queue, TaskController *task)
+		{
+#ifdef KERNEL_TRACE
+			Trace::record(TraceEvent::queueTimeout, task, static_cast<uint32_t>(reinterpret_cast<uintptr_t>(queue)));
+#endif
+		}
+
+		/* Event group*/
+		static void onEventGroupSet(EventGroup *group, uint32_t mask)
+		{
+#ifdef KERNEL_TRACE
+			Trace::record(TraceEvent::eventGroupSet, mask);
+#endif
+		}
+
+		static void onEventGroupWait(EventGroup *group, TaskController *waiter, uint32_t timeout)
+		{
+#ifdef KERNEL_TRACE
+			Trace::record(TraceEvent::eventGroupWait, waiter, static_cast<uint32_t>(reinterpret_cast<uintptr_t>(group)));
+#endif
+		}
+
+		static void onEventGroupTimeout(EventGroup *group, TaskController *task)
+		{
+#ifdef KERNEL_TRACE
+			Trace::record(TraceEvent::eventGroupTimeout, task, static_cast<uint32_t>(reinterpret_cast<uintptr_t>(group)));
+#endif
+		}
+
+		/* Task notification*/
+		static void onTaskNotify(TaskController *task, uint32_t value)
+		{
+#ifdef KERNEL_TRACE
+			Trace::record(TraceEvent::taskNotify, task, value);
+#endif
+		}
+
+		static void onNotificationWait(TaskController *waiter, uint32_t timeout)
+		{
+#ifdef KERNEL_TRACE
+			Trace::record(TraceEvent::notificationWait, waiter, timeout);
+#endif
+		}
+
+		static void onNotificationTimeout(TaskController *task)
+		{
+#ifdef KERNEL_TRACE
+			Trace::record(TraceEvent::notificationTimeout, task);
+#endif
 		}
 	};
 } // namespace kernel
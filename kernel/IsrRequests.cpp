@@ -0,0 +1,87 @@
+/*MIT License
+
+Copyright (c) 2019 Florian GERARD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Except as contained in this notice, the name of Florian GERARD shall not be used 
+in advertising or otherwise to promote the sale, use or other dealings in this 
+Software without prior written authorization from Florian GERARD
+
+*/
+
+#include "IsrRequests.hpp"
+#include "Scheduler.hpp"
+#include "core/Core.hpp"
+
+
+namespace kernel
+{
+	framework::LockFreeRing<IsrRequests::Request, config::isrRequestSlots> IsrRequests::s_pending;
+
+	bool IsrRequests::post(Type type, void *object, uint32_t value)
+	{
+		Y_ASSERT(object != nullptr);
+		if (!s_pending.push(Request{type, object, value}))
+			return false;
+		if (Scheduler::s_schedulerStarted) //before start, requests wait for first task
+			core::Core::contextSwitchTrigger();
+		return true;
+	}
+
+	void IsrRequests::applyPending()
+	{
+		Request request;
+		while (s_pending.pop(request))
+		{
+			switch (request.type)
+			{
+			case Type::signalEvent:
+				Event::kernelSignalEvent(reinterpret_cast<Event *>(request.object));
+				break;
+			case Type::giveSemaphore:
+				Semaphore::kernelGiveSemaphore(reinterpret_cast<Semaphore *>(request.object), request.value);
+				break;
+			case Type::wakeQueue:
+				MessageQueueBase::kernelWakeReceivers(reinterpret_cast<MessageQueueBase *>(request.object));
+				break;
+			case Type::setEventGroup:
+				EventGroup::kernelSetEventGroup(reinterpret_cast<EventGroup *>(request.object), request.value);
+				break;
+			case Type::notifySetBits:
+				Notification::kernelNotify(reinterpret_cast<TaskController *>(request.object), request.value, NotifyAction::setBits);
+				break;
+			case Type::notifyIncrement:
+				Notification::kernelNotify(reinterpret_cast<TaskController *>(request.object), request.value, NotifyAction::increment);
+				break;
+			case Type::notifyOverwrite:
+				Notification::kernelNotify(reinterpret_cast<TaskController *>(request.object), request.value, NotifyAction::overwrite);
+				break;
+			default:
+				Y_ASSERT(false);
+				break;
+			}
+		}
+	}
+
+	bool IsrRequests::isEmpty()
+	{
+		return s_pending.isEmpty();
+	}
+} // namespace kernel
@@ -0,0 +1,75 @@
+/*MIT License
+
+Copyright (c) 2019 Florian GERARD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Except as contained in this notice, the name of Florian GERARD shall not be used 
+in advertising or otherwise to promote the sale, use or other dealings in this 
+Software without prior written authorization from Florian GERARD
+
+*/
+
+#pragma once
+
+#include <cstdint>
+
+#include "Config.hpp"
+#include "yggdrasil/framework/LockFreeRing.hpp"
+
+
+namespace kernel
+{
+	/* Kernel requests from interrupt handlers
+	 * an interrupt never calls kernel (SVC from a handler is a HardFault) nor touch its lists,
+	 * it records its request in a lock free ring and pends the context switch interrupt which applies it */
+	class IsrRequests
+	{
+		friend class Scheduler;
+	public:
+		enum class Type : uint8_t
+		{
+			signalEvent = 0,
+			giveSemaphore = 1,
+			wakeQueue = 2,
+			setEventGroup = 3,
+			notifySetBits = 4,
+			notifyIncrement = 5,
+			notifyOverwrite = 6,
+		};
+
+		/* record a request and pend its processing
+		 * return false if too many requests are pending, request is dropped*/
+		static bool post(Type type, void *object, uint32_t value = 0);
+
+	private:
+		struct Request
+		{
+			Type type;
+			void *object;
+			uint32_t value;
+		};
+
+		static framework::LockFreeRing<Request, config::isrRequestSlots> s_pending;
+
+		// apply every pending request, called from kernel with kernel interrupts locked
+		static void applyPending();
+		static bool isEmpty();
+	};
+} // namespace kernel
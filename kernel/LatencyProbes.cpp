@@ -0,0 +1,118 @@
+/*MIT License
+
+Copyright (c) 2019 Florian GERARD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Except as contained in this notice, the name of Florian GERARD shall not be used 
+in advertising or otherwise to promote the sale, use or other dealings in this 
+Software without prior written authorization from Florian GERARD
+
+*/
+
+#include "LatencyProbes.hpp"
+#include "Scheduler.hpp"
+#include "core/Core.hpp"
+
+#ifdef KERNEL_LATENCY_PROBES
+
+namespace kernel
+{
+	framework::Histogram<> LatencyProbes::s_histograms[static_cast<uint32_t>(LatencyProbe::count)];
+
+	bool LatencyProbes::snapshot(LatencyProbe probe, LatencyStatistics &statistics)
+	{
+		return supervisorCallSnapshot(probe, &statistics);
+	}
+
+	void LatencyProbes::reset()
+	{
+		supervisorCallReset();
+	}
+
+	const char *LatencyProbes::name(LatencyProbe probe)
+	{
+		switch (probe)
+		{
+		case LatencyProbe::serviceCall:
+			return "serviceCall";
+		case LatencyProbe::taskSwitch:
+			return "taskSwitch";
+		case LatencyProbe::systemTick:
+			return "systemTick";
+		case LatencyProbe::readyToRun:
+			return "readyToRun";
+		default:
+			return "unknown";
+		}
+	}
+
+	uint64_t LatencyProbes::begin()
+	{
+		return Scheduler::getCycles();
+	}
+
+	void LatencyProbes::end(LatencyProbe probe, uint64_t start)
+	{
+		uint64_t elapsed = Scheduler::getCycles() - start;
+		s_histograms[static_cast<uint32_t>(probe)].record((elapsed > UINT32_MAX) ? UINT32_MAX : static_cast<uint32_t>(elapsed));
+	}
+
+	void LatencyProbes::onTaskReady(TaskController *task)
+	{
+		if (task == Scheduler::s_activeTask) // preempted, it was not waiting for anything
+			return;
+		task->m_readyCycles = Scheduler::getCycles();
+	}
+
+	void LatencyProbes::onTaskStartExec(TaskController *task)
+	{
+		if (task->m_readyCycles == 0) // first run, or resumed without being made ready
+			return;
+		end(LatencyProbe::readyToRun, task->m_readyCycles);
+		task->m_readyCycles = 0;
+	}
+
+	bool LatencyProbes::kernelSnapshot(LatencyProbe probe, LatencyStatistics *statistics)
+	{
+		if (probe >= LatencyProbe::count)
+			return false;
+		const framework::Histogram<> &histogram = s_histograms[static_cast<uint32_t>(probe)];
+		statistics->count = histogram.count();
+		statistics->minimum = histogram.minimum();
+		statistics->mean = histogram.mean();
+		statistics->median = histogram.percentile(500);
+		statistics->percentile90 = histogram.percentile(900);
+		statistics->percentile99 = histogram.percentile(990);
+		statistics->maximum = histogram.maximum();
+		return true;
+	}
+
+	bool LatencyProbes::kernelReset()
+	{
+		for (framework::Histogram<> &histogram : s_histograms)
+			histogram.reset();
+		return true;
+	}
+
+	LatencyProbes::SupervisorCallSnapshot LatencyProbes::supervisorCallSnapshot = core::Core::supervisorCall<ServiceCall::SvcNumber::latencySnapshot, bool, LatencyProbe, LatencyStatistics*>;
+	LatencyProbes::SupervisorCallReset LatencyProbes::supervisorCallReset = core::Core::supervisorCall<ServiceCall::SvcNumber::latencyReset, bool>;
+} // namespace kernel
+
+#endif // KERNEL_LATENCY_PROBES
@@ -0,0 +1,96 @@
+/*MIT License
+
+Copyright (c) 2019 Florian GERARD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Except as contained in this notice, the name of Florian GERARD shall not be used 
+in advertising or otherwise to promote the sale, use or other dealings in this 
+Software without prior written authorization from Florian GERARD
+
+*/
+
+#pragma once
+
+#include <cstdint>
+
+#include "Task.hpp"
+#include "ServiceCall.hpp"
+#include "yggdrasil/framework/Histogram.hpp"
+
+
+namespace kernel
+{
+	/* Kernel paths measured by latency probes*/
+	enum class LatencyProbe : uint8_t
+	{
+		serviceCall = 0, // kernel side of a service call
+		taskSwitch = 1, // context switch handler, register save and restore excluded
+		systemTick = 2, // system timer tick, grows with number of timeouts expiring together
+		readyToRun = 3, // from a task made ready (event, mutex hand over, interrupt request, timeout) to its first instruction
+		count
+	};
+
+	/* Latency distribution of a probe, in core cycles, percentiles rounded up to histogram resolution*/
+	struct LatencyStatistics
+	{
+		uint32_t count;
+		uint32_t minimum;
+		uint32_t mean;
+		uint32_t median;
+		uint32_t percentile90;
+		uint32_t percentile99;
+		uint32_t maximum;
+	};
+
+	/* Latency probes, built when KERNEL_LATENCY_PROBES is defined
+	 * each probe feeds a histogram from the cycle clock, its resolution is the one of system timer cycle counter
+	 * measurements run in kernel handlers, results are read with snapshot while tasks keep running */
+	class LatencyProbes
+	{
+		friend class Scheduler;
+		friend class Hooks;
+	public:
+		// return false if probe does not exist
+		static bool snapshot(LatencyProbe probe, LatencyStatistics &statistics);
+
+		// forget every measurement
+		static void reset();
+
+		// probe name, for reports
+		static const char *name(LatencyProbe probe);
+
+	private:
+		static framework::Histogram<> s_histograms[static_cast<uint32_t>(LatencyProbe::count)];
+
+		static uint64_t begin();
+		static void end(LatencyProbe probe, uint64_t start);
+		static void onTaskReady(TaskController *task);
+		static void onTaskStartExec(TaskController *task);
+
+		static bool kernelSnapshot(LatencyProbe probe, LatencyStatistics *statistics);
+		static bool kernelReset();
+
+		using SupervisorCallSnapshot = bool(&)(LatencyProbe, LatencyStatistics*);
+		static SupervisorCallSnapshot& supervisorCallSnapshot;
+
+		using SupervisorCallReset = bool(&)();
+		static SupervisorCallReset& supervisorCallReset;
+	};
+} // namespace kernel
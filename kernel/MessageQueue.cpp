@@ -0,0 +1,277 @@
+/*MIT License
+
+Copyright (c) 2019 Florian GERARD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Except as contained in this notice, the name of Florian GERARD shall not be used 
+in advertising or otherwise to promote the sale, use or other dealings in this 
+Software without prior written authorization from Florian GERARD
+
+*/
+
+#include "MessageQueue.hpp"
+#include "Hooks.hpp"
+#include "IsrRequests.hpp"
+#include "Scheduler.hpp"
+#include "core/Core.hpp"
+
+
+namespace kernel
+{
+	uint32_t MessageQueueBase::count()
+	{
+		uint32_t position = __atomic_load_n(&m_receivePosition, __ATOMIC_RELAXED);
+		uint32_t ready = 0;
+		while (ready < m_capacity && __atomic_load_n(&m_sequence[position % m_capacity], __ATOMIC_ACQUIRE) == advance(position, 1))
+		{
+			ready++;
+			position = advance(position, 1);
+		}
+		return ready;
+	}
+
+	bool MessageQueueBase::someoneWaiting()
+	{
+		return !m_senders.isEmpty() || !m_receivers.isEmpty();
+	}
+
+	int16_t MessageQueueBase::reserveSend(uint32_t timeout)
+	{
+		Y_ASSERT(Scheduler::inThreadMode());
+		int16_t slot = takeWriteSlot();
+		if (slot >= 0)
+			return slot;
+		return supervisorCallReserveSend(this, timeout);
+	}
+
+	void MessageQueueBase::commitSend(uint32_t slot)
+	{
+		Y_ASSERT(slot < m_capacity);
+		Hooks::onQueueSend(this);
+		// slot owner is the only writer of its sequence until it is published
+		__atomic_store_n(&m_sequence[slot], advance(m_sequence[slot], 1), __ATOMIC_RELEASE);
+		__atomic_thread_fence(__ATOMIC_SEQ_CST); // published before looking for receivers, kernel queues them before looking for messages
+		if (!m_receivers.isEmpty())
+			supervisorCallWakeReceivers(this);
+	}
+
+	int16_t MessageQueueBase::reserveReceive(uint32_t timeout)
+	{
+		Y_ASSERT(Scheduler::inThreadMode());
+		int16_t slot = takeReadSlot();
+		if (slot >= 0)
+			return slot;
+		return supervisorCallReserveReceive(this, timeout);
+	}
+
+	void MessageQueueBase::releaseReceive(uint32_t slot)
+	{
+		Y_ASSERT(slot < m_capacity);
+		Hooks::onQueueReceive(this);
+		// position + 1 becomes position + capacity: free for next lap
+		__atomic_store_n(&m_sequence[slot], advance(m_sequence[slot], m_capacity - 1), __ATOMIC_RELEASE);
+		__atomic_thread_fence(__ATOMIC_SEQ_CST);
+		if (!m_senders.isEmpty())
+			supervisorCallWakeSenders(this);
+	}
+
+	int16_t MessageQueueBase::reserveSendFromIsr()
+	{
+		return takeWriteSlot();
+	}
+
+	bool MessageQueueBase::commitSendFromIsr(uint32_t slot)
+	{
+		Y_ASSERT(slot < m_capacity);
+		Hooks::onQueueSend(this);
+		// published first, a lost wake up request delays a waiting receiver instead of losing the message
+		__atomic_store_n(&m_sequence[slot], advance(m_sequence[slot], 1), __ATOMIC_RELEASE);
+		__atomic_thread_fence(__ATOMIC_SEQ_CST);
+		if (m_receivers.isEmpty())
+			return true;
+		return IsrRequests::post(IsrRequests::Type::wakeQueue, this);
+	}
+
+	int16_t MessageQueueBase::takeWriteSlot()
+	{
+		uint32_t position = __atomic_load_n(&m_sendPosition, __ATOMIC_RELAXED);
+		while (true)
+		{
+			uint32_t slot = position % m_capacity;
+			uint32_t sequence = __atomic_load_n(&m_sequence[slot], __ATOMIC_ACQUIRE);
+			if (sequence == position)
+			{
+				// failed exchange reloads position, an other sender got it
+				if (__atomic_compare_exchange_n(&m_sendPosition, &position, advance(position, 1), true, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+					return static_cast<int16_t>(slot);
+			}
+			else if (advance(sequence, m_capacity) == position || advance(sequence, m_capacity - 1) == position)
+				return -1; // message of previous lap is not read yet
+			else
+				position = __atomic_load_n(&m_sendPosition, __ATOMIC_RELAXED); // position read was stale
+		}
+	}
+
+	int16_t MessageQueueBase::takeReadSlot()
+	{
+		uint32_t position = __atomic_load_n(&m_receivePosition, __ATOMIC_RELAXED);
+		while (true)
+		{
+			uint32_t slot = position % m_capacity;
+			uint32_t sequence = __atomic_load_n(&m_sequence[slot], __ATOMIC_ACQUIRE);
+			uint32_t filled = advance(position, 1);
+			if (sequence == filled)
+			{
+				if (__atomic_compare_exchange_n(&m_receivePosition, &position, filled, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+					return static_cast<int16_t>(slot);
+			}
+			else if (sequence == position || advance(sequence, m_capacity - 1) == position)
+				return -1; // message is not committed yet, or slot still holds previous lap
+			else
+				position = __atomic_load_n(&m_receivePosition, __ATOMIC_RELAXED);
+		}
+	}
+
+	uint32_t MessageQueueBase::advance(uint32_t position, uint32_t distance)
+	{
+		uint32_t next = position + distance;
+		return (next >= m_positions) ? next - m_positions : next;
+	}
+
+	bool MessageQueueBase::wakeReceivers()
+	{
+		bool woken = false;
+		int16_t slot;
+		while (!m_receivers.isEmpty() && (slot = takeReadSlot()) >= 0)
+		{
+			handSlot(m_receivers, static_cast<uint32_t>(slot));
+			woken = true;
+		}
+		return woken;
+	}
+
+	bool MessageQueueBase::wakeSenders()
+	{
+		bool woken = false;
+		int16_t slot;
+		while (!m_senders.isEmpty() && (slot = takeWriteSlot()) >= 0)
+		{
+			handSlot(m_senders, static_cast<uint32_t>(slot));
+			woken = true;
+		}
+		return woken;
+	}
+
+	void MessageQueueBase::handSlot(EventList &waiters, uint32_t slot)
+	{
+		TaskController *newReadyTask = waiters.getFirst();
+		Y_ASSERT(!Scheduler::s_ready.contain(newReadyTask)); //If the queue ready task is already in ready list, we have a problem
+		newReadyTask->m_waitingFor = nullptr;
+		stopWait(newReadyTask);
+		newReadyTask->setReturnValue(static_cast<int16_t>(slot)); // reserved slot is the service call result
+		Scheduler::s_ready.insert(newReadyTask);
+		newReadyTask->m_state = kernel::TaskController::State::ready;
+		Hooks::onTaskReady(newReadyTask);
+	}
+
+	int16_t MessageQueueBase::blockActiveTask(EventList &waiters, uint32_t duration)
+	{
+		TaskController *task = Scheduler::s_activeTask;
+		Y_ASSERT(task != nullptr);
+		// queued before taking again: an interrupt sending meanwhile either is seen here or sees the receiver
+		waiters.insert(task, TaskController::priorityCompare);
+		__atomic_thread_fence(__ATOMIC_SEQ_CST);
+		int16_t slot = (&waiters == &m_receivers) ? takeReadSlot() : takeWriteSlot();
+		if (slot >= 0)
+		{
+			waiters.remove(task);
+			return slot;
+		}
+		if (duration > 0)
+		{
+			task->m_wakeUpTimeStamp = Scheduler::s_ticks + duration;
+			Scheduler::s_timers.insert(task, Scheduler::s_ticks);
+		}
+		task->m_waitingFor = this;
+		task->m_waitValue = (&waiters == &m_senders) ? waitingToSend : 0;
+		task->m_state = kernel::TaskController::State::waitingQueue;
+		Scheduler::s_taskToStack = task;
+		Scheduler::s_activeTask = Scheduler::s_ready.getFirst();
+		Hooks::onQueueWait(this, task, duration);
+		Scheduler::setPendSv(kernel::Scheduler::changeTaskTrigger::waitForQueue);
+		return -1; // overwritten with the slot handed by the task waking it
+	}
+
+	int16_t MessageQueueBase::kernelReserveSend(MessageQueueBase *queue, uint32_t duration)
+	{
+		int16_t slot = queue->takeWriteSlot(); // released since fast path failed
+		if (slot >= 0)
+			return slot;
+		return queue->blockActiveTask(queue->m_senders, duration);
+	}
+
+	bool MessageQueueBase::kernelWakeReceivers(MessageQueueBase *queue)
+	{
+		if (queue->wakeReceivers())
+			Scheduler::schedule(kernel::Scheduler::changeTaskTrigger::wakeByQueue);
+		return true;
+	}
+
+	int16_t MessageQueueBase::kernelReserveReceive(MessageQueueBase *queue, uint32_t duration)
+	{
+		int16_t slot = queue->takeReadSlot(); // committed since fast path failed
+		if (slot >= 0)
+			return slot;
+		return queue->blockActiveTask(queue->m_receivers, duration);
+	}
+
+	bool MessageQueueBase::kernelWakeSenders(MessageQueueBase *queue)
+	{
+		if (queue->wakeSenders())
+			Scheduler::schedule(kernel::Scheduler::changeTaskTrigger::wakeByQueue);
+		return true;
+	}
+
+	void MessageQueueBase::stopWait(TaskController *task)
+	{
+		if (Scheduler::s_timers.remove(task))
+			task->m_wakeUpTimeStamp = 0;
+	}
+
+	void MessageQueueBase::onTimeout(TaskController *task)
+	{
+		Y_ASSERT(task->m_waitingFor == this);
+		EventList &waiters = (task->m_waitValue == waitingToSend) ? m_senders : m_receivers;
+		waiters.remove(task);
+		task->m_waitingFor = nullptr; //the task is no more waiting for queue
+		task->setReturnValue(static_cast<int16_t>(-1)); // timeout code
+		task->m_wakeUpTimeStamp = 0;
+		Scheduler::s_ready.insert(task);
+		task->m_state = kernel::TaskController::State::ready;
+		Hooks::onQueueTimeout(this, task);
+		Hooks::onTaskReady(task);
+		Scheduler::schedule(kernel::Scheduler::changeTaskTrigger::queueTimeout);
+	}
+
+	MessageQueueBase::SupervisorCallReserve MessageQueueBase::supervisorCallReserveSend = core::Core::supervisorCall<ServiceCall::SvcNumber::queueReserveSend, int16_t, MessageQueueBase*, uint32_t>;
+	MessageQueueBase::SupervisorCallWake MessageQueueBase::supervisorCallWakeReceivers = core::Core::supervisorCall<ServiceCall::SvcNumber::queueWakeReceivers, bool, MessageQueueBase*>;
+	MessageQueueBase::SupervisorCallReserve MessageQueueBase::supervisorCallReserveReceive = core::Core::supervisorCall<ServiceCall::SvcNumber::queueReserveReceive, int16_t, MessageQueueBase*, uint32_t>;
+	MessageQueueBase::SupervisorCallWake MessageQueueBase::supervisorCallWakeSenders = core::Core::supervisorCall<ServiceCall::SvcNumber::queueWakeSenders, bool, MessageQueueBase*>;
+} // End namespace kernel
@@ -0,0 +1,210 @@
+/*MIT License
+
+Copyright (c) 2019 Florian GERARD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Except as contained in this notice, the name of Florian GERARD shall not be used 
+in advertising or otherwise to promote the sale, use or other dealings in this 
+Software without prior written authorization from Florian GERARD
+
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <new>
+#include <utility>
+
+#include "Task.hpp"
+#include "ServiceCall.hpp"
+#include "yggdrasil/interfaces/IWaitable.hpp"
+
+
+namespace kernel
+{
+	/* Kernel part of message queues, independent of message type
+	 * a message slot is reserved, filled or read in place by the task, then committed or released,
+	 * each slot has a sequence number telling, for a queue position, whether it is free, filled or read:
+	 * slots are reserved and completed lock free in any order, receivers still get them in reservation order
+	 * kernel is only called to wait for a slot or to hand one to a waiting task */
+	class MessageQueueBase : public interfaces::IWaitable
+	{
+		friend class Scheduler;
+		friend class IsrRequests;
+	public:
+
+		// number of messages ready to be received
+		uint32_t count();
+
+		bool someoneWaiting();
+
+	protected:
+
+		constexpr MessageQueueBase(volatile uint32_t *sequence, uint32_t capacity, const char *name) :
+			m_senders(), m_receivers(), m_sequence(sequence), m_capacity(capacity), m_positions(capacity * (0x80000000u / capacity)),
+			m_sendPosition(0), m_receivePosition(0), m_name(name)
+		{
+		}
+
+		// reserve a free slot, waiting for it if queue is full
+		//@return slot index, -1 if timeout
+		int16_t reserveSend(uint32_t timeout);
+		// make a filled slot available to receivers
+		void commitSend(uint32_t slot);
+		// reserve oldest message slot, waiting for it if queue is empty
+		//@return slot index, -1 if timeout
+		int16_t reserveReceive(uint32_t timeout);
+		// give back a read slot to senders
+		void releaseReceive(uint32_t slot);
+
+		// same as reserveSend and commitSend from an interrupt, never wait, a waiting receiver is woken by kernel once interrupts are done
+		//@return slot index, -1 if queue is full
+		int16_t reserveSendFromIsr();
+		//@return false if too many interrupt requests are pending, message is kept and a waiting receiver is not woken before next send
+		bool commitSendFromIsr(uint32_t slot);
+
+	private:
+		EventList m_senders;
+		EventList m_receivers;
+		volatile uint32_t *const m_sequence; // per slot: position it is free for, that position + 1 once filled
+		const uint32_t m_capacity;
+		const uint32_t m_positions; // positions wrap at this multiple of capacity, far enough to tell laps apart
+		volatile uint32_t m_sendPosition; // next position to reserve for sending
+		volatile uint32_t m_receivePosition; // next position to reserve for receiving
+		const char *m_name;
+		static constexpr uint32_t waitingToSend = 1; // wait value of a task in senders, 0 in receivers
+
+		// reserve slot of next send position, lock free
+		//@return slot index, -1 if queue is full
+		int16_t takeWriteSlot();
+		// reserve slot of next receive position if its message is committed, lock free
+		//@return slot index, -1 if queue is empty
+		int16_t takeReadSlot();
+		// position moved forward by distance, at most capacity
+		uint32_t advance(uint32_t position, uint32_t distance);
+		// hand free or filled slots to waiting tasks, return true if a task was woken
+		bool wakeSenders();
+		bool wakeReceivers();
+		// remove first waiter, give it slot and make it ready
+		void handSlot(EventList &waiters, uint32_t slot);
+
+		static int16_t kernelReserveSend(MessageQueueBase *queue, uint32_t duration);
+		static bool kernelWakeReceivers(MessageQueueBase *queue);
+		static int16_t kernelReserveReceive(MessageQueueBase *queue, uint32_t duration);
+		static bool kernelWakeSenders(MessageQueueBase *queue);
+		// wait on waiters list unless a slot is taken meanwhile
+		//@return slot index taken without waiting, -1 if task waits
+		int16_t blockActiveTask(EventList &waiters, uint32_t duration);
+		void stopWait(TaskController *task) final;
+		void onTimeout(TaskController *task) final;
+
+		using SupervisorCallReserve = int16_t(&)(MessageQueueBase*, uint32_t);
+		using SupervisorCallWake = bool(&)(MessageQueueBase*);
+		static SupervisorCallReserve& supervisorCallReserveSend;
+		static SupervisorCallWake& supervisorCallWakeReceivers;
+		static SupervisorCallReserve& supervisorCallReserveReceive;
+		static SupervisorCallWake& supervisorCallWakeSenders;
+	};
+
+	/* Fixed size message queue with static storage
+	 * messages are constructed and consumed directly in queue slots, send and receive are copies on top of it*/
+	template<typename T, uint32_t Size>
+	class MessageQueue : public MessageQueueBase
+	{
+		static_assert(Size > 0 && Size <= INT16_MAX, "slot index must fit service call return value");
+	public:
+		constexpr MessageQueue(const char *name = nullptr) : MessageQueueBase(m_sequence, Size, name), m_storage(), m_sequence()
+		{
+			for (uint32_t i = 0; i < Size; i++) // each slot is free for first lap
+				m_sequence[i] = i;
+		}
+
+		/* copy message in queue
+		 * -timeout specify a time in ms to wait for a free slot, 0 for no timeout
+		 * return 1 if success, -1 if timeout*/
+		int16_t send(const T &message, uint32_t timeout = 0)
+		{
+			return emplace(timeout, message);
+		}
+
+		/* construct message in place in a free slot, arguments are given to T constructor
+		 * return 1 if success, -1 if timeout*/
+		template<typename... Args>
+		int16_t emplace(uint32_t timeout, Args&&... args)
+		{
+			int16_t slot = reserveSend(timeout);
+			if (slot < 0)
+				return -1;
+			new (slotAt(slot)) T(std::forward<Args>(args)...);
+			commitSend(static_cast<uint32_t>(slot));
+			return 1;
+		}
+
+		/* move oldest message out of queue
+		 * return 1 if success, -1 if timeout*/
+		int16_t receive(T &message, uint32_t timeout = 0)
+		{
+			return consume([&message](T &queued) { message = std::move(queued); }, timeout);
+		}
+
+		/* give oldest message in place to consumer (callable taking T&), message is destroyed once consumer returns
+		 * return 1 if success, -1 if timeout*/
+		template<typename Consumer>
+		int16_t consume(Consumer &&consumer, uint32_t timeout = 0)
+		{
+			int16_t slot = reserveReceive(timeout);
+			if (slot < 0)
+				return -1;
+			T *message = slotAt(slot);
+			consumer(*message);
+			message->~T();
+			releaseReceive(static_cast<uint32_t>(slot));
+			return 1;
+		}
+
+		// copy message in queue from an interrupt, return false if queue is full
+		bool sendFromIsr(const T &message)
+		{
+			return emplaceFromIsr(message);
+		}
+
+		/* construct message in place from an interrupt, return false if queue is full
+		 * a queued message is never lost, when interrupt requests overflow a waiting receiver gets it after next send*/
+		template<typename... Args>
+		bool emplaceFromIsr(Args&&... args)
+		{
+			int16_t slot = reserveSendFromIsr();
+			if (slot < 0)
+				return false;
+			new (slotAt(slot)) T(std::forward<Args>(args)...);
+			commitSendFromIsr(static_cast<uint32_t>(slot));
+			return true;
+		}
+
+	private:
+		alignas(T) uint8_t m_storage[Size][sizeof(T)];
+		volatile uint32_t m_sequence[Size];
+
+		T *slotAt(int16_t slot)
+		{
+			return reinterpret_cast<T *>(m_storage[slot]);
+		}
+	};
+} // namespace kernel
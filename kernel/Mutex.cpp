@@ -38,40 +38,77 @@ namespace kernel
 	int16_t Mutex::lock(uint32_t timeout)
 	{
 		Y_ASSERT(Scheduler::inThreadMode());
+		// free mutex is taken without kernel, an exception between exclusive load and store makes it fail
+		uintptr_t expected = 0;
+		TaskController *self = Scheduler::s_activeTask;
+		if (__atomic_compare_exchange_n(&m_lockWord, &expected, reinterpret_cast<uintptr_t>(self), false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+		{
+			Hooks::onMutexLock(this, self);
+			return 1;
+		}
 		return supervisorCallLockMutex(this, timeout);
 	}
 	
 	bool Mutex::release()
 	{
+		// without waiters the lock word only holds owner address, clear it without kernel
+		uintptr_t expected = reinterpret_cast<uintptr_t>(Scheduler::s_activeTask);
+		if (__atomic_compare_exchange_n(&m_lockWord, &expected, 0, false, __ATOMIC_RELEASE, __ATOMIC_RELAXED))
+		{
+			Hooks::onMutexRelease(this);
+			return true;
+		}
 		return supervisorCallReleaseMutex(this);
 	}
 	
 	bool Mutex::isLocked()
 	{
-		return m_owner != nullptr;
+		return m_lockWord != 0;
+	}
+
+	TaskController *Mutex::owner()
+	{
+		return reinterpret_cast<TaskController *>(m_lockWord & ~waitersFlag);
+	}
+
+	// mutex is listed in owner mutexes only while it has waiters, priority inheritance only needs those
+	void Mutex::setOwner(TaskController *owner, bool hasWaiters)
+	{
+		if (hasWaiters)
+		{
+			m_lockWord = reinterpret_cast<uintptr_t>(owner) | waitersFlag;
+			if (!framework::DualLinkNode<Mutex, OwnedMutexList>::isLinked(this)) // only ever listed by its owner
+				owner->m_ownedMutexes.insertFirst(this);
+		}
+		else
+			m_lockWord = reinterpret_cast<uintptr_t>(owner);
 	}
 	
 	// A task want to get a mutex wait for it if already lock by someone else or get it if free
 	int16_t Mutex::kernelLockMutex(Mutex* mutex, uint32_t duration)
 	{
 		Y_ASSERT(Scheduler::s_activeTask != nullptr);
-		if (mutex->m_owner == nullptr)
+		TaskController *owner = mutex->owner();
+		if (owner == nullptr) // released since fast path failed
 		{
 			Hooks::onMutexLock(mutex, Scheduler::s_activeTask);
-			mutex->m_owner = Scheduler::s_activeTask;
+			mutex->setOwner(Scheduler::s_activeTask, false);
 			return 1;
 		}
 		else
 		{
 			Y_ASSERT(Scheduler::s_activeTask != nullptr);
+			Y_ASSERT(owner != Scheduler::s_activeTask); // recursive lock
 			mutex->m_waiting.insert(Scheduler::s_activeTask, TaskController::priorityCompare);
+			mutex->setOwner(owner, true); // owner release now has to go through kernel
 			if (duration > 0)
 			{
 				Scheduler::s_activeTask->m_wakeUpTimeStamp = Scheduler::s_ticks + duration;
-				Scheduler::s_waiting.insert(Scheduler::s_activeTask, TaskController::sleepCompare);
+				Scheduler::s_timers.insert(Scheduler::s_activeTask, Scheduler::s_ticks);
 			}
 			Scheduler::s_activeTask->m_waitingFor = mutex;
 			Scheduler::s_activeTask->m_state = kernel::TaskController::State::waitingMutex;
+			updatePriority(owner); // owner inherits waiter priority before next task is elected
 			Scheduler::s_taskToStack = Scheduler::s_activeTask;
 			Scheduler::s_activeTask = Scheduler::s_ready.getFirst();
 			Hooks::onMutexWait(mutex, Scheduler::s_taskToStack, duration);
@@ -82,19 +119,18 @@ namespace kernel
 
 	void Mutex::stopWait(TaskController *task)
 	{
-		if (task->m_wakeUpTimeStamp != 0)
-		{
-			Scheduler::s_waiting.remove(task);
+		if (Scheduler::s_timers.remove(task))
 			task->m_wakeUpTimeStamp = 0;
-		}
 	}
 
 	bool Mutex::kernelReleaseMutex(Mutex* mutex)
 	{
 		Y_ASSERT(mutex != nullptr);
 		Hooks::onMutexRelease(mutex);
-		if (mutex->m_owner == nullptr) // this should not append
+		TaskController *previousOwner = mutex->owner();
+		if (previousOwner == nullptr) // this should not append
 			return false;
+		previousOwner->m_ownedMutexes.remove(mutex);
 		if (!mutex->m_waiting.isEmpty())
 		{
 			TaskController* newReadyTask = mutex->m_waiting.getFirst();
@@ -102,37 +138,148 @@ namespace kernel
 			Y_ASSERT(!Scheduler::s_ready.contain(newReadyTask)); //If the event ready task is already in ready list, we have a problem
 			newReadyTask->m_waitingFor = nullptr;
 			mutex->stopWait(newReadyTask);
-			Scheduler::s_ready.insert(newReadyTask, TaskController::priorityCompare);
+			Scheduler::s_ready.insert(newReadyTask);
 			newReadyTask->m_state = kernel::TaskController::State::ready;
-			mutex->m_owner = newReadyTask;
+			mutex->setOwner(newReadyTask, !mutex->m_waiting.isEmpty());
+			updatePriority(newReadyTask); // new owner inherits from remaining waiters
+			updatePriority(previousOwner); // previous owner drops what it inherited through this mutex
 			Hooks::onTaskReady(newReadyTask);
 			Hooks::onMutexLock(mutex, newReadyTask);
 			Scheduler::schedule(kernel::Scheduler::changeTaskTrigger::wakeByMutex);
 		}
 		else
 		{
-			mutex->m_owner = nullptr;
+			mutex->m_lockWord = 0;
 		}
 		return true;
 	}
 
 	void Mutex::onTimeout(TaskController* task)
 	{
-		Hooks::onMutexTimeout(this, task);
-		Y_ASSERT(m_waiting.contain(task));
+		Y_ASSERT(task->m_waitingFor == this);
 		m_waiting.remove(task);
-		Y_ASSERT(!m_waiting.contain(task));
 		task->m_waitingFor = nullptr; //the task is no more waiting for mutex
 		task->setReturnValue(static_cast<int16_t>(-1)); // timeout code
 		task->m_wakeUpTimeStamp = 0;
-		Scheduler::s_ready.insert(task, TaskController::priorityCompare);
+		Scheduler::s_ready.insert(task);
 		task->m_state = kernel::TaskController::State::ready;
+		TaskController *owner = this->owner();
+		if (m_waiting.isEmpty()) // last waiter gone, owner may release without kernel again
+		{
+			owner->m_ownedMutexes.remove(this);
+			setOwner(owner, false);
+		}
+		updatePriority(owner); // owner may have inherited from the timed out task
 		Hooks::onMutexTimeout(this, task);
 		Hooks::onTaskReady(task);
 		Scheduler::schedule(kernel::Scheduler::changeTaskTrigger::mutexTimeout);	
 	}
 	
+	uint32_t Mutex::inheritedPriority(TaskController *task)
+	{
+		uint32_t priority = task->m_basePriority;
+		uint32_t ceiling = CeilingMutex::ceilingOf(task);
+		if (ceiling > priority)
+			priority = ceiling;
+		for (Mutex *owned = task->m_ownedMutexes.peekFirst(); owned != nullptr; owned = framework::DualLinkNode<Mutex, OwnedMutexList>::next(owned))
+		{
+			TaskController *firstWaiter = owned->m_waiting.peekFirst(); // waiters are sorted by priority
+			if (firstWaiter != nullptr && firstWaiter->m_priority > priority)
+				priority = firstWaiter->m_priority;
+		}
+		return priority;
+	}
+
+	void Mutex::updatePriority(TaskController *task)
+	{
+		while (task != nullptr)
+		{
+			uint32_t priority = inheritedPriority(task);
+			if (priority == task->m_priority) // chain is already up to date
+				return;
+			Scheduler::changePriority(task, priority);
+			if (task->m_state != TaskController::State::waitingMutex)
+				return;
+			// task is itself blocked, reorder it among waiters and go on with the owner blocking it
+			Mutex *blocking = static_cast<Mutex *>(task->m_waitingFor);
+			blocking->m_waiting.remove(task);
+			blocking->m_waiting.insert(task, TaskController::priorityCompare);
+			task = blocking->owner();
+		}
+	}
+
+	int16_t CeilingMutex::lock(uint32_t)
+	{
+		Y_ASSERT(Scheduler::inThreadMode());
+		TaskController *self = Scheduler::s_activeTask;
+		Y_ASSERT(self->m_basePriority <= m_ceiling);
+		if (m_owner != nullptr) // cannot happen between tasks below ceiling
+			return 0;
+		m_owner = self;
+		m_outer = self->m_ceilings;
+		uint32_t outerCeiling = ceilingOf(self);
+		m_heldCeiling = (outerCeiling > m_ceiling) ? outerCeiling : m_ceiling;
+		self->m_ceilings = this; // from now on kernel keeps priority at least at ceiling when it recomputes it
+		// active task is not in ready queue, raise it without kernel
+		// kernel may raise it meanwhile (inheritance), exclusive store fails then and new value is compared again
+		uint8_t priority = __atomic_load_n(&self->m_priority, __ATOMIC_RELAXED);
+		while (priority < m_heldCeiling && !__atomic_compare_exchange_n(&self->m_priority, &priority, static_cast<uint8_t>(m_heldCeiling), true, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+			;
+		return 1;
+	}
+
+	bool CeilingMutex::release()
+	{
+		TaskController *self = Scheduler::s_activeTask;
+		if (m_owner != self)
+			return false;
+		Y_ASSERT(self->m_ceilings == this); // reverse lock order
+		uint32_t remaining = (m_outer != nullptr) ? m_outer->m_heldCeiling : 0;
+		if (self->m_basePriority > remaining)
+			remaining = self->m_basePriority;
+		bool rotate = (m_outer == nullptr) && Scheduler::isTimeSliceOverdue(self);
+		if (m_heldCeiling <= remaining && !rotate) // ceiling did not raise priority, an outer one or base priority keeps it where it is
+		{
+			self->m_ceilings = m_outer;
+			m_owner = nullptr;
+			return true;
+		}
+		return supervisorCallRelease(this);
+	}
+
+	uint32_t CeilingMutex::ceilingOf(TaskController *task)
+	{
+		CeilingMutex *innermost = task->m_ceilings;
+		return (innermost != nullptr) ? innermost->m_heldCeiling : 0;
+	}
+
+	bool CeilingMutex::kernelRelease(CeilingMutex *mutex)
+	{
+		TaskController *self = Scheduler::s_activeTask;
+		if (mutex->m_owner != self)
+			return false;
+		self->m_ceilings = mutex->m_outer;
+		mutex->m_owner = nullptr;
+		// recompute instead of restoring priority seen at lock, inheritance may have changed since
+		Mutex::updatePriority(self);
+		if (self->m_ceilings == nullptr && Scheduler::isTimeSliceOverdue(self)) // quantum ran out under the ceiling, rotate now
+		{
+			if (Scheduler::yield(kernel::Scheduler::changeTaskTrigger::timeSliceOver))
+				return true;
+			Scheduler::s_timeSliceLeft = Scheduler::s_timeSlices[self->m_priority];
+		}
+		// a task readied while priority was raised could not preempt, it does now
+		Scheduler::schedule(kernel::Scheduler::changeTaskTrigger::priorityRestored);
+		return true;
+	}
+
+	bool CeilingMutex::isLocked()
+	{
+		return m_owner != nullptr;
+	}
+
 	Mutex::SupervisorCallLockMutex Mutex::supervisorCallLockMutex  = core::Core::supervisorCall < ServiceCall::SvcNumber::mutexLock, int16_t, Mutex*, uint32_t>;
 	Mutex::SupervisorCallReleaseMutex Mutex::supervisorCallReleaseMutex = core::Core::supervisorCall < ServiceCall::SvcNumber::mutexRelease, bool, Mutex*>;
+	CeilingMutex::SupervisorCallRelease CeilingMutex::supervisorCallRelease = core::Core::supervisorCall < ServiceCall::SvcNumber::ceilingMutexRelease, bool, CeilingMutex*>;
 
 }// End namespace kernel
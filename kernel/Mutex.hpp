@@ -29,6 +29,7 @@ Software without prior written authorization from Florian GERARD
 #pragma once
 
 #include "Task.hpp"
+#include "Config.hpp"
 #include "ServiceCall.hpp"
 #include "yggdrasil/interfaces/IWaitable.hpp"
 
@@ -37,12 +38,17 @@ namespace kernel
 {
 	
 	
-	class Mutex : public interfaces::IWaitable
+	/* Mutex with priority inheritance
+	 * owner runs at the priority of its highest priority waiter, transitively through nested mutexes,
+	 * and gets back its own priority when released
+	 * lock and release of a mutex without waiters are done in thread mode with exclusive access, kernel is only called on contention */
+	class Mutex : public interfaces::IWaitable, public framework::DualLinkNode<Mutex, OwnedMutexList>
 	{
 		friend class Scheduler;
+		friend class CeilingMutex;
 	public:
 		
-		constexpr Mutex(): m_owner(nullptr)
+		constexpr Mutex(): m_waiting(), m_lockWord(0)
 		{
 		}
 
@@ -56,13 +62,23 @@ namespace kernel
 		bool isLocked();
 		
 	private:
+		static constexpr uintptr_t waitersFlag = 1; // task controllers are word aligned, bit 0 is free
+
 		EventList m_waiting;
-		TaskController *m_owner;
+		volatile uintptr_t m_lockWord; // owner address, ored with waitersFlag when kernel holds waiters
+
+		TaskController *owner();
+		void setOwner(TaskController *owner, bool hasWaiters);
 
 		static int16_t kernelLockMutex(Mutex* mutex, uint32_t duration);
 		static bool kernelReleaseMutex(Mutex* mutex);
 		void stopWait(TaskController *task);
 		void onTimeout(TaskController* task);
+
+		// priority a task should run at, highest of its own, its ceiling mutexes and the first waiter of any mutex it owns
+		static uint32_t inheritedPriority(TaskController *task);
+		// apply inherited priority to task and along the chain of mutex owners it is blocked by
+		static void updatePriority(TaskController *task);
 		
 		// call kernel to lock mutex
 		//@return int16_t, 1 if when succes, -1 if timeout, 0 if error
@@ -76,12 +92,59 @@ namespace kernel
 		using SupervisorCallReleaseMutex = bool(&)(Mutex*);
 		static SupervisorCallReleaseMutex& supervisorCallReleaseMutex;
 	};
+
+	/* Immediate priority ceiling mutex
+	 * locking raises the caller straight to the ceiling, which must be at least the priority of every task using it,
+	 * so no other user can run until release: lock never blocks and needs no service call
+	 * ceiling mutexes of a task are released in reverse lock order, they combine with Mutex priority inheritance:
+	 * a task runs at the highest of its own priority, its ceilings and its inherited priority
+	 * time slicing does not rotate a task holding a ceiling, a peer of its level could use it: an expired quantum rotates at release
+	 * release goes through kernel when it may lower running priority */
+	class CeilingMutex
+	{
+		friend class Scheduler;
+		friend class Mutex;
+	public:
+
+		// a ceiling above highest priority level is clamped to it, as task priorities are
+		constexpr CeilingMutex(uint32_t ceiling) : m_ceiling((ceiling < config::priorityLevels) ? ceiling : config::priorityLevels - 1), m_owner(nullptr), m_outer(nullptr), m_heldCeiling(0)
+		{
+			Y_ASSERT(ceiling < config::priorityLevels);
+		}
+
+		/* lock ressource, timeout is unused as lock never waits, kept to be interchangeable with Mutex
+		 * return 1 if success, 0 if already locked (recursive lock or user above ceiling)*/
+		int16_t lock(uint32_t timeout = 0);
+
+		bool release();
+
+		bool isLocked();
+
+	private:
+		const uint32_t m_ceiling;
+		TaskController *m_owner;
+		CeilingMutex *m_outer; // ceiling mutex owner held before this one
+		uint32_t m_heldCeiling; // highest ceiling of this one and outer ones
+
+		//@return highest ceiling held by task, 0 if none
+		static uint32_t ceilingOf(TaskController *task);
+		static bool kernelRelease(CeilingMutex *mutex);
+
+		// call kernel to release mutex, restore running priority and give processor to a task readied above it
+		//@return bool, true if success, false if caller is not owner
+		//@params pointer to mutex to release
+		using SupervisorCallRelease = bool(&)(CeilingMutex*);
+		static SupervisorCallRelease& supervisorCallRelease;
+	};
 	
-template<class ObjectType>
+/* Object only reachable while its mutex is locked
+ * MutexType may be Mutex or CeilingMutex, extra constructor arguments are given to the mutex (ceiling priority)*/
+template<class ObjectType, class MutexType = Mutex>
 	class ObjectMutex
 	{
 	public:
-		constexpr ObjectMutex(ObjectType& object) : m_object(object), m_mutex()
+		template<typename... MutexArgs>
+		constexpr ObjectMutex(ObjectType& object, MutexArgs... mutexArgs) : m_object(object), m_mutex(mutexArgs...)
 		{
 			
 		}
@@ -110,6 +173,6 @@ template<class ObjectType>
 	private:
 
 		ObjectType& m_object;
-		Mutex m_mutex;
+		MutexType m_mutex;
 	};
 	}
@@ -0,0 +1,157 @@
+/*MIT License
+
+Copyright (c) 2019 Florian GERARD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Except as contained in this notice, the name of Florian GERARD shall not be used 
+in advertising or otherwise to promote the sale, use or other dealings in this 
+Software without prior written authorization from Florian GERARD
+
+*/
+
+#include "Notification.hpp"
+#include "Hooks.hpp"
+#include "IsrRequests.hpp"
+#include "Scheduler.hpp"
+#include "core/Core.hpp"
+
+
+namespace kernel
+{
+	Notification Notification::s_waitable;
+
+	bool TaskController::notify(uint32_t value, NotifyAction action)
+	{
+		return Notification::supervisorCallNotify(this, value, action);
+	}
+
+	bool TaskController::notifyFromIsr(uint32_t value, NotifyAction action)
+	{
+		switch (action)
+		{
+		case NotifyAction::setBits:
+			return IsrRequests::post(IsrRequests::Type::notifySetBits, this, value);
+		case NotifyAction::increment:
+			return IsrRequests::post(IsrRequests::Type::notifyIncrement, this, value);
+		case NotifyAction::overwrite:
+			return IsrRequests::post(IsrRequests::Type::notifyOverwrite, this, value);
+		default:
+			Y_ASSERT(false);
+			return false;
+		}
+	}
+
+	int16_t Notification::wait(uint32_t &value, uint32_t timeout, bool clearOnExit)
+	{
+		Y_ASSERT(Scheduler::inThreadMode());
+		return supervisorCallWaitNotification(&value, clearOnExit, timeout);
+	}
+
+	uint32_t Notification::take(TaskController *task, bool clearOnExit)
+	{
+		uint32_t value = task->m_notificationValue;
+		task->m_notificationPending = false;
+		if (clearOnExit)
+			task->m_notificationValue = 0;
+		return value;
+	}
+
+	// A task wait for a notification, return immediately if one is pending
+	int16_t Notification::kernelWaitNotification(uint32_t *value, bool clearOnExit, uint32_t duration)
+	{
+		TaskController *task = Scheduler::s_activeTask;
+		Y_ASSERT(task != nullptr);
+		if (task->m_notificationPending)
+		{
+			*value = take(task, clearOnExit);
+			return 1;
+		}
+		task->m_waitValue = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(value)); // written by notifier
+		task->m_waitOptions = clearOnExit;
+		if (duration > 0)
+		{
+			task->m_wakeUpTimeStamp = Scheduler::s_ticks + duration;
+			Scheduler::s_timers.insert(task, Scheduler::s_ticks);
+		}
+		task->m_waitingFor = &s_waitable;
+		task->m_state = kernel::TaskController::State::waitingNotification;
+		Scheduler::s_taskToStack = task;
+		Scheduler::s_activeTask = Scheduler::s_ready.getFirst();
+		Hooks::onNotificationWait(task, duration);
+		Scheduler::setPendSv(kernel::Scheduler::changeTaskTrigger::waitForNotification);
+		return 1; // used to return from interrupt, overwritten on timeout
+	}
+
+	bool Notification::kernelNotify(TaskController *task, uint32_t value, NotifyAction action)
+	{
+		Y_ASSERT(task != nullptr);
+		Hooks::onTaskNotify(task, value);
+		switch (action)
+		{
+		case NotifyAction::setBits:
+			task->m_notificationValue |= value;
+			break;
+		case NotifyAction::increment:
+			task->m_notificationValue += value;
+			break;
+		case NotifyAction::overwrite:
+			task->m_notificationValue = value;
+			break;
+		default:
+			Y_ASSERT(false);
+			break;
+		}
+		if (task->m_state != kernel::TaskController::State::waitingNotification)
+		{
+			task->m_notificationPending = true;
+			return true;
+		}
+		*reinterpret_cast<uint32_t *>(static_cast<uintptr_t>(task->m_waitValue)) = take(task, task->m_waitOptions != 0);
+		Y_ASSERT(!Scheduler::s_ready.contain(task)); //If the notified task is already in ready list, we have a problem
+		task->m_waitingFor = nullptr;
+		s_waitable.stopWait(task);
+		Scheduler::s_ready.insert(task);
+		task->m_state = kernel::TaskController::State::ready;
+		Hooks::onTaskReady(task);
+		Scheduler::schedule(kernel::Scheduler::changeTaskTrigger::wakeByNotification);
+		return true;
+	}
+
+	void Notification::stopWait(TaskController *task)
+	{
+		if (Scheduler::s_timers.remove(task))
+			task->m_wakeUpTimeStamp = 0;
+	}
+
+	void Notification::onTimeout(TaskController *task)
+	{
+		task->m_waitingFor = nullptr; //the task is no more waiting for notification
+		task->setReturnValue(static_cast<int16_t>(-1)); // timeout code
+		task->m_wakeUpTimeStamp = 0;
+		Scheduler::s_ready.insert(task);
+		task->m_state = kernel::TaskController::State::ready;
+		Hooks::onNotificationTimeout(task);
+		Hooks::onTaskReady(task);
+		Scheduler::schedule(kernel::Scheduler::changeTaskTrigger::notificationTimeout);
+	}
+
+	Notification::SupervisorCallWaitNotification Notification::supervisorCallWaitNotification = core::Core::supervisorCall<ServiceCall::SvcNumber::waitNotification, int16_t, uint32_t*, bool, uint32_t>;
+	Notification::SupervisorCallNotify Notification::supervisorCallNotify = core::Core::supervisorCall<ServiceCall::SvcNumber::notifyTask, bool, TaskController*, uint32_t, NotifyAction>;
+} // End namespace kernel
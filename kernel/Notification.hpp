@@ -0,0 +1,84 @@
+/*MIT License
+
+Copyright (c) 2019 Florian GERARD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Except as contained in this notice, the name of Florian GERARD shall not be used 
+in advertising or otherwise to promote the sale, use or other dealings in this 
+Software without prior written authorization from Florian GERARD
+
+*/
+
+#pragma once
+
+#include <cstdint>
+
+#include "Task.hpp"
+#include "ServiceCall.hpp"
+#include "yggdrasil/interfaces/IWaitable.hpp"
+
+
+namespace kernel
+{
+	/* Direct to task notifications
+	 * every task holds a 32 bits notification value updated by notifiers, no kernel object is needed
+	 * a single waitable instance handles timeouts of every task waiting for a notification */
+	class Notification : public interfaces::IWaitable
+	{
+		friend class Scheduler;
+		friend class IsrRequests;
+		friend class TaskController;
+	public:
+
+		/* wait for a notification of the calling task
+		 * -value receives the notification value
+		 * -timeout specify a time in ms to wait, 0 for no timeout
+		 * -clearOnExit reset notification value to 0 once read
+		 * return 1 if success, -1 if timeout*/
+		static int16_t wait(uint32_t &value, uint32_t timeout = 0, bool clearOnExit = true);
+
+	private:
+		constexpr Notification()
+		{
+		}
+
+		static Notification s_waitable;
+
+		// read notification value and mark it consumed
+		static uint32_t take(TaskController *task, bool clearOnExit);
+
+		static int16_t kernelWaitNotification(uint32_t *value, bool clearOnExit, uint32_t duration);
+		static bool kernelNotify(TaskController *task, uint32_t value, NotifyAction action);
+		void stopWait(TaskController *task) final;
+		void onTimeout(TaskController *task) final;
+
+		// call kernel to wait for a notification
+		//@return int16_t, 1 if success, -1 if timeout
+		//@params pointer receiving value, clear on exit, optional timeout (0 to disable)
+		using SupervisorCallWaitNotification = int16_t(&)(uint32_t*, bool, uint32_t);
+		static SupervisorCallWaitNotification& supervisorCallWaitNotification;
+
+		// call kernel to notify a task
+		//@return bool, always true
+		//@params task to notify, value, action to apply on task value
+		using SupervisorCallNotify = bool(&)(TaskController*, uint32_t, NotifyAction);
+		static SupervisorCallNotify& supervisorCallNotify;
+	};
+} // namespace kernel
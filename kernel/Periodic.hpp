@@ -0,0 +1,90 @@
+/*MIT License
+
+Copyright (c) 2019 Florian GERARD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Except as contained in this notice, the name of Florian GERARD shall not be used 
+in advertising or otherwise to promote the sale, use or other dealings in this 
+Software without prior written authorization from Florian GERARD
+
+*/
+
+#pragma once
+
+#include <cstdint>
+
+#include "Api.hpp"
+
+
+namespace kernel
+{
+	/* Release a periodic task at a fixed rate
+	 * release times are computed from the first release, not from wake up times, so execution time and jitter never drift the period
+	 * a release missed because the task ran late is skipped and counted as overrun */
+	class Periodic
+	{
+	public:
+		// first release is one period after start tick (now if not given)
+		Periodic(uint32_t period, uint64_t start = Api::getTicks()) : m_period(period), m_lastRelease(start), m_overruns(0)
+		{
+			Y_ASSERT(period != 0);
+		}
+
+		/* sleep until next release
+		 * return number of releases missed since previous call, 0 if on time*/
+		uint32_t waitNextPeriod()
+		{
+			uint64_t next = m_lastRelease + m_period;
+			uint64_t now = Api::getTicks();
+			uint32_t missed = 0;
+			if (next < now) // late, skip to first release not passed yet
+			{
+				missed = static_cast<uint32_t>((now - 1 - next) / m_period) + 1;
+				next += static_cast<uint64_t>(missed) * m_period;
+				m_overruns += missed;
+			}
+			m_lastRelease = next;
+			Api::sleepUntil(next);
+			return missed;
+		}
+
+		// tick of current release
+		uint64_t lastRelease() const
+		{
+			return m_lastRelease;
+		}
+
+		// releases missed since construction
+		uint32_t overruns() const
+		{
+			return m_overruns;
+		}
+
+		uint32_t period() const
+		{
+			return m_period;
+		}
+
+	private:
+		const uint32_t m_period;
+		uint64_t m_lastRelease;
+		uint32_t m_overruns;
+	};
+} // namespace kernel
@@ -0,0 +1,151 @@
+/*MIT License
+
+Copyright (c) 2019 Florian GERARD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Except as contained in this notice, the name of Florian GERARD shall not be used 
+in advertising or otherwise to promote the sale, use or other dealings in this 
+Software without prior written authorization from Florian GERARD
+
+*/
+
+#pragma once
+
+#include <cstdint>
+
+#include "Config.hpp"
+#include "Task.hpp"
+#include "yggdrasil/framework/Assertion.hpp"
+
+namespace kernel
+{
+	/* Ready tasks container
+	 * one FIFO per priority level and a bitmap of non empty levels,
+	 * highest ready level is found with a count leading zero so insertion and election do not depend on the number of tasks */
+	class ReadyQueue
+	{
+	public:
+		constexpr ReadyQueue() : m_levels(), m_bitmap(0), m_count(0)
+		{
+		}
+
+		// add task at the end of its priority level
+		void insert(TaskController *task)
+		{
+			Y_ASSERT(task != nullptr);
+			uint32_t level = task->m_priority;
+			Y_ASSERT(level < config::priorityLevels);
+			m_levels[level].insertEnd(task);
+			m_bitmap = m_bitmap | (1U << level);
+			m_count++;
+		}
+
+		bool remove(TaskController *task)
+		{
+			if (!contain(task))
+				return false;
+			uint32_t level = task->m_priority;
+			Y_ASSERT(level < config::priorityLevels);
+			m_levels[level].remove(task);
+			if (m_levels[level].isEmpty())
+				m_bitmap = m_bitmap & ~(1U << level);
+			m_count--;
+			return true;
+		}
+
+		// highest priority ready task, first arrived if several share the level
+		TaskController *peekFirst()
+		{
+			if (m_bitmap == 0)
+				return nullptr;
+			return m_levels[highestLevel()].peekFirst();
+		}
+
+		TaskController *getFirst()
+		{
+			if (m_bitmap == 0)
+				return nullptr;
+			uint32_t level = highestLevel();
+			TaskController *task = m_levels[level].getFirst();
+			if (m_levels[level].isEmpty())
+				m_bitmap = m_bitmap & ~(1U << level);
+			m_count--;
+			return task;
+		}
+
+		// highest ready priority, 0 if none, reads a single word so it can be used out of kernel
+		uint32_t highestPriority()
+		{
+			uint32_t bitmap = m_bitmap;
+			if (bitmap == 0)
+				return 0;
+			return 31U - static_cast<uint32_t>(__builtin_clz(bitmap));
+		}
+
+		// state links are shared with waiting lists, a linked task is in ready queue only in ready state
+		bool contain(TaskController *task)
+		{
+			if (task == nullptr)
+				return false;
+			return task->m_state == TaskController::State::ready && ReadyLink::isLinked(task);
+		}
+
+		bool isEmpty()
+		{
+			return m_bitmap == 0;
+		}
+
+		uint32_t count()
+		{
+			return m_count;
+		}
+
+		// walk every level: bitmap matches non empty levels, tasks are ready at their running priority, count is right
+		bool isConsistent()
+		{
+			uint32_t total = 0;
+			for (uint32_t level = 0; level < config::priorityLevels; level++)
+			{
+				if (m_levels[level].isEmpty() == ((m_bitmap & (1U << level)) != 0))
+					return false;
+				for (TaskController *task = m_levels[level].peekFirst(); task != nullptr; task = ReadyLink::next(task))
+				{
+					if (task->m_priority != level || task->m_state != TaskController::State::ready)
+						return false;
+					total++;
+				}
+			}
+			return total == m_count;
+		}
+
+	private:
+		using ReadyLink = framework::DualLinkNode<TaskController, StateLink>;
+
+		ReadyList m_levels[config::priorityLevels];
+		volatile uint32_t m_bitmap; // bit n set when level n holds at least one task
+		uint32_t m_count;
+
+		// only valid when bitmap is not empty
+		uint32_t highestLevel()
+		{
+			return 31U - static_cast<uint32_t>(__builtin_clz(m_bitmap));
+		}
+	};
+} // namespace kernel
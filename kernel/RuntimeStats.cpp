@@ -0,0 +1,115 @@
+/*MIT License
+
+Copyright (c) 2019 Florian GERARD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Except as contained in this notice, the name of Florian GERARD shall not be used 
+in advertising or otherwise to promote the sale, use or other dealings in this 
+Software without prior written authorization from Florian GERARD
+
+*/
+
+#include "RuntimeStats.hpp"
+#include "Scheduler.hpp"
+#include "core/Core.hpp"
+
+#ifdef KERNEL_RUNTIME_STATS
+
+namespace kernel
+{
+	uint64_t RuntimeStats::s_startCycles = 0;
+	uint64_t RuntimeStats::s_lastSwitchCycles = 0;
+
+	uint32_t RuntimeStats::snapshot(TaskStatistics *stats, uint32_t maxTasks)
+	{
+		return supervisorCallSnapshot(stats, maxTasks);
+	}
+
+	uint32_t RuntimeStats::cpuLoad()
+	{
+		return supervisorCallCpuLoad();
+	}
+
+	void RuntimeStats::onKernelStart()
+	{
+		s_startCycles = Scheduler::getCycles();
+		s_lastSwitchCycles = s_startCycles;
+	}
+
+	void RuntimeStats::onTaskSwitch(TaskController *previous, TaskController *next)
+	{
+		uint64_t now = Scheduler::getCycles();
+		uint64_t run = now - s_lastSwitchCycles;
+		s_lastSwitchCycles = now;
+		previous->m_runCycles += run;
+		if (run > previous->m_maxRunCycles)
+			previous->m_maxRunCycles = run;
+		if (previous->m_state == TaskController::State::ready) // still able to run, processor was taken
+			previous->m_preemptionCount++;
+		next->m_switchCount++;
+	}
+
+	uint64_t RuntimeStats::runCycles(TaskController *task, uint64_t now)
+	{
+		if (task == Scheduler::s_activeTask && Scheduler::s_taskToStack == nullptr) // running now, current run not charged yet
+			return task->m_runCycles + (now - s_lastSwitchCycles);
+		return task->m_runCycles;
+	}
+
+	uint32_t RuntimeStats::share(uint64_t part, uint64_t total)
+	{
+		if (total == 0)
+			return 0;
+		return static_cast<uint32_t>(part * 10000 / total);
+	}
+
+	uint32_t RuntimeStats::kernelSnapshot(TaskStatistics *stats, uint32_t maxTasks)
+	{
+		uint64_t now = Scheduler::getCycles();
+		uint64_t elapsed = now - s_startCycles;
+		uint32_t index = 0;
+		for (TaskController *task = Scheduler::s_started.peekFirst(); task != nullptr; task = StartedLink::next(task), index++)
+		{
+			if (index >= maxTasks)
+				continue; // go on counting
+			TaskStatistics &entry = stats[index];
+			entry.name = task->m_name;
+			entry.priority = task->m_basePriority;
+			entry.runCycles = runCycles(task, now);
+			entry.maxRunCycles = task->m_maxRunCycles;
+			entry.switches = task->m_switchCount;
+			entry.preemptions = task->m_preemptionCount;
+			entry.load = share(entry.runCycles, elapsed);
+		}
+		return index;
+	}
+
+	uint32_t RuntimeStats::kernelCpuLoad()
+	{
+		uint64_t now = Scheduler::getCycles();
+		uint64_t idle = runCycles(&core::Core::idleTask.data, now); // a task may share idle priority
+		return 10000 - share(idle, now - s_startCycles);
+	}
+
+	RuntimeStats::SupervisorCallSnapshot RuntimeStats::supervisorCallSnapshot = core::Core::supervisorCall<ServiceCall::SvcNumber::runtimeStatsSnapshot, uint32_t, TaskStatistics*, uint32_t>;
+	RuntimeStats::SupervisorCallCpuLoad RuntimeStats::supervisorCallCpuLoad = core::Core::supervisorCall<ServiceCall::SvcNumber::runtimeStatsCpuLoad, uint32_t>;
+} // namespace kernel
+
+#endif // KERNEL_RUNTIME_STATS
@@ -0,0 +1,89 @@
+/*MIT License
+
+Copyright (c) 2019 Florian GERARD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Except as contained in this notice, the name of Florian GERARD shall not be used 
+in advertising or otherwise to promote the sale, use or other dealings in this 
+Software without prior written authorization from Florian GERARD
+
+*/
+
+#pragma once
+
+#include <cstdint>
+
+#include "Task.hpp"
+#include "ServiceCall.hpp"
+
+
+namespace kernel
+{
+	/* Statistics of a task at snapshot time*/
+	struct TaskStatistics
+	{
+		const char *name;
+		uint32_t priority; // base priority, 0 for idle task
+		uint64_t runCycles; // core cycles spent running since kernel start
+		uint64_t maxRunCycles; // longest run without losing processor
+		uint32_t switches; // times task got processor
+		uint32_t preemptions; // times task lost processor while still ready
+		uint32_t load; // share of elapsed time spent running, in hundredths of percent
+	};
+
+	/* Runtime statistics, built when KERNEL_RUNTIME_STATS is defined
+	 * every context switch charges cycles elapsed since previous switch to the task leaving processor
+	 * snapshots are taken by kernel without stopping tasks */
+	class RuntimeStats
+	{
+		friend class Scheduler;
+	public:
+		/* fill at most maxTasks statistics, one per started task ordered by priority
+		 * return number of started tasks, may be more than maxTasks*/
+		static uint32_t snapshot(TaskStatistics *stats, uint32_t maxTasks);
+
+		// processor load since kernel start, time not spent in idle task, in hundredths of percent
+		static uint32_t cpuLoad();
+
+	private:
+#ifdef KERNEL_STARTED_LIST
+		using StartedLink = framework::DualLinkNode<TaskController, StartedList>;
+#endif // KERNEL_STARTED_LIST
+
+		static uint64_t s_startCycles; // cycle clock at first task start
+		static uint64_t s_lastSwitchCycles; // cycle clock at last context switch
+
+		static void onKernelStart();
+		// charge elapsed cycles to previous task, count a switch for next one
+		static void onTaskSwitch(TaskController *previous, TaskController *next);
+		// cycles run by task, including current run if it is active
+		static uint64_t runCycles(TaskController *task, uint64_t now);
+		static uint32_t share(uint64_t part, uint64_t total);
+
+		static uint32_t kernelSnapshot(TaskStatistics *stats, uint32_t maxTasks);
+		static uint32_t kernelCpuLoad();
+
+		using SupervisorCallSnapshot = uint32_t(&)(TaskStatistics*, uint32_t);
+		static SupervisorCallSnapshot& supervisorCallSnapshot;
+
+		using SupervisorCallCpuLoad = uint32_t(&)();
+		static SupervisorCallCpuLoad& supervisorCallCpuLoad;
+	};
+} // namespace kernel
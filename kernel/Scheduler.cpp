@@ -34,7 +34,9 @@ namespace kernel
 {
 	bool Scheduler::s_schedulerStarted = false;
 	bool Scheduler::s_interruptInstalled = false;
-	volatile uint64_t Scheduler::s_ticks = 0;
+	volatile uint64_t Scheduler::s_ticks = config::initialTicks;
+	volatile uint64_t Scheduler::s_publishedTicks[2] = {config::initialTicks, config::initialTicks};
+	volatile uint32_t Scheduler::s_tickSequence = 0;
 	volatile Scheduler::changeTaskTrigger Scheduler::s_trigger = Scheduler::changeTaskTrigger::none;		
 	TaskController* volatile Scheduler::s_activeTask = nullptr;
 	TaskController* volatile Scheduler::s_taskToStack = nullptr;
@@ -43,12 +45,21 @@ namespace kernel
 	volatile uint8_t Scheduler::s_lockLevel = 0;
 	volatile bool Scheduler::s_isKernelLocked = false;
 	uint32_t Scheduler::s_sysTickFreq = 1000;
+	uint32_t Scheduler::s_coreFrequency = 0;
+	uint32_t Scheduler::s_cyclesPerTick = 0;
+	std::array<uint32_t, config::priorityLevels> Scheduler::s_timeSlices = []() {
+		std::array<uint32_t, config::priorityLevels> slices{};
+		slices.fill(config::defaultTimeSlice);
+		return slices;
+	}();
+	uint32_t Scheduler::s_timeSliceLeft = 0;
 	uint8_t Scheduler::s_systemPriority = 0;
 
+#ifdef KERNEL_STARTED_LIST
 	StartedList Scheduler::s_started;
-	ReadyList Scheduler::s_ready;
-	SleepingList Scheduler::s_sleeping;
-	WaitableList Scheduler::s_waiting;
+#endif // KERNEL_STARTED_LIST
+	ReadyQueue Scheduler::s_ready;
+	TimerWheel Scheduler::s_timers;
 
 	/*-------------------------------------------------------------------------------------------*/
 	/*                                                                                           */
@@ -69,11 +80,17 @@ namespace kernel
 		if (s_ready.isEmpty()) //No Task in task list, cannot start Scheduler
 			return false;
 
+#ifdef KERNEL_TICKLESS
+		core::Core::idleTask.start(idleTaskFunction, true, 0, 0, "idle"); // Add idle task, stop ticking while idle
+#else
 		core::Core::idleTask.start(core::Core::idleFunc,true,0, 0, "idle"); // Add idle task
+#endif
 		if (!installKernelInterrupt())
 			return false;
 		//Init Systick
-		core::Core::systemTimer.initSystemTimer(core::Core::coreClocks.getSystemCoreFrequency(), s_sysTickFreq);
+		s_coreFrequency = core::Core::coreClocks.getSystemCoreFrequency();
+		s_cyclesPerTick = s_coreFrequency / s_sysTickFreq;
+		core::Core::systemTimer.initSystemTimer(s_coreFrequency, s_sysTickFreq);
 		core::Core::systemTimer.startSystemTimer();
 		Hooks::onKernelStart();
 		core::Core::supervisorCall < ServiceCall::SvcNumber::startFirstTask, void>();		 
@@ -109,8 +126,16 @@ namespace kernel
 	{
 		//start a task, reset main stack pointer
 		s_activeTask = s_ready.getFirst();
+		s_activeTask->m_state = TaskController::State::active;
+		s_timeSliceLeft = s_timeSlices[s_activeTask->m_priority];
+#ifdef KERNEL_RUNTIME_STATS
+		RuntimeStats::onKernelStart();
+		s_activeTask->m_switchCount++;
+#endif // KERNEL_RUNTIME_STATS
 		Hooks::onTaskStartExec(s_activeTask);
 		s_schedulerStarted = true;
+		if (!IsrRequests::isEmpty()) //requests posted by interrupts before start are applied once first task runs
+			core::Core::contextSwitchTrigger();
 		core::Core::restoreTask(Scheduler::s_activeTask->m_stackPointer);
 		return true; //should never return here
 	}
@@ -158,8 +183,10 @@ namespace kernel
 	{
 		if (task.m_state != TaskController::State::notStarted)
 			return false;
+#ifdef KERNEL_STARTED_LIST
 		s_started.insert(&task, TaskController::priorityCompare);
-		s_ready.insert(&task, TaskController::priorityCompare);
+#endif // KERNEL_STARTED_LIST
+		s_ready.insert(&task);
 		task.m_state = TaskController::State::ready;
 		Hooks::onTaskStart(&task);
 		if (s_schedulerStarted)
@@ -175,21 +202,7 @@ namespace kernel
 		{
 			if (s_ready.peekFirst()->m_priority > s_activeTask->m_priority) //a task with higher priority is waiting, trigger context switching
 			{
-				//Store currently running task
-				Y_ASSERT(!s_ready.contain(s_activeTask)); //currently running task not already in ready list
-				Y_ASSERT(!s_sleeping.contain(s_activeTask));
-				s_ready.insert(s_activeTask, TaskController::priorityCompare);
-				Hooks::onTaskStopExec(s_activeTask);
-				Hooks::onTaskReady(s_activeTask);
-				if (s_taskToStack == nullptr)
-					s_taskToStack = s_activeTask;
-				s_activeTask = nullptr;
-				//If there is no task to be saved already, put active task in s_previousTask to save context
-				s_taskToStack->m_state = kernel::TaskController::State::ready;
-				//Take the first available task
-				s_activeTask = s_ready.getFirst();
-				Y_ASSERT(s_activeTask != nullptr);
-				setPendSv(trigger);
+				preemptActiveTask(trigger);
 				return true;
 			}
 			else
@@ -201,11 +214,67 @@ namespace kernel
 		return false;
 	}
 
+	bool Scheduler::yield(changeTaskTrigger trigger)
+	{
+		Y_ASSERT(s_activeTask != nullptr);
+		TaskController *first = s_ready.peekFirst();
+		if (first == nullptr || first->m_priority < s_activeTask->m_priority) //nobody to share processor with
+			return false;
+		preemptActiveTask(trigger);
+		return true;
+	}
+
+	void Scheduler::preemptActiveTask(changeTaskTrigger trigger)
+	{
+		//Store currently running task
+		Y_ASSERT(!s_ready.contain(s_activeTask)); //currently running task not already in ready list
+		Y_ASSERT(!s_timers.contain(s_activeTask));
+		s_ready.insert(s_activeTask);
+		s_activeTask->m_state = kernel::TaskController::State::ready; // task to stack may be another one, already sleeping or waiting
+		Hooks::onTaskStopExec(s_activeTask);
+		Hooks::onTaskReady(s_activeTask);
+		//If there is no task to be saved already, put active task in s_previousTask to save context
+		if (s_taskToStack == nullptr)
+			s_taskToStack = s_activeTask;
+		s_activeTask = nullptr;
+		//Take the first available task
+		s_activeTask = s_ready.getFirst();
+		Y_ASSERT(s_activeTask != nullptr);
+		setPendSv(trigger);
+	}
+
+	void Scheduler::changePriority(TaskController *task, uint32_t priority)
+	{
+		Y_ASSERT(priority < config::priorityLevels);
+		if (s_ready.remove(task)) // ready queue is indexed by priority, requeue task
+		{
+			task->m_priority = priority;
+			s_ready.insert(task);
+		}
+		else
+			task->m_priority = priority;
+	}
+
+	bool Scheduler::consumeTimeSlice()
+	{
+		// a context switch already pending means active task has not started its quantum yet
+		if (s_activeTask == nullptr || s_trigger != kernel::Scheduler::changeTaskTrigger::none)
+			return false;
+		if (s_timeSliceLeft == 0) // not sliced, or quantum already over under a ceiling
+			return false;
+		s_timeSliceLeft--;
+		if (s_activeTask->m_ceilings != nullptr) // a peer may use the same ceiling, rotation waits for release
+			return false;
+		return s_timeSliceLeft == 0;
+	}
+
 	bool Scheduler::stopTask(TaskController *task)
 	{
 		s_ready.remove(task);
-		s_sleeping.remove(task);
+		s_timers.remove(task);
+#ifdef KERNEL_STARTED_LIST
 		s_started.remove(task);
+#endif // KERNEL_STARTED_LIST
 		task->m_state = TaskController::State::notStarted;
 		Hooks::onTaskClose(task);
 		if (s_activeTask == task)
@@ -217,18 +286,30 @@ namespace kernel
 	}
 
 	bool __attribute__((optimize("O0"))) Scheduler::sleep(uint32_t ms)
+	{
+		return enterSleep(s_ticks + ms);
+	}
+
+	bool Scheduler::sleepUntil(uint64_t tick)
+	{
+		if (tick <= s_ticks) // release time already reached, keep running
+			return false;
+		return enterSleep(tick);
+	}
+
+	bool Scheduler::enterSleep(uint64_t tick)
 	{
 		// should be triggered directly from task
 		Y_ASSERT(s_activeTask != nullptr);
 		Y_ASSERT(s_taskToStack == nullptr);
 		s_taskToStack = s_activeTask;
 		s_activeTask = nullptr; // no more active task
-		s_taskToStack->m_wakeUpTimeStamp = s_ticks + ms;
+		s_taskToStack->m_wakeUpTimeStamp = tick;
 		//Put active Task to sleep
-		Y_ASSERT(!s_sleeping.contain(s_taskToStack)); // if active task already in sleeping list we have a problem
-		s_sleeping.insert(s_taskToStack, TaskController::sleepCompare);
+		Y_ASSERT(!s_timers.contain(s_taskToStack)); // if active task already in timer wheel we have a problem
+		s_timers.insert(s_taskToStack, s_ticks);
 		s_taskToStack->m_state = TaskController::State::sleeping;
-		Hooks::onTaskSleep(s_taskToStack, ms);
+		Hooks::onTaskSleep(s_taskToStack, static_cast<uint32_t>(tick - s_ticks));
 		s_activeTask = s_ready.getFirst();
 		Y_ASSERT(s_activeTask != nullptr);							 // ready list should at least contain idle task
 		setPendSv(kernel::Scheduler::changeTaskTrigger::enterSleep); //active task is sleeping, trigger context switch
@@ -248,6 +329,24 @@ namespace kernel
 
 	volatile uint32_t *__attribute__((optimize("O0"))) Scheduler::taskSwitch(uint32_t *stackPosition)
 	{
+#ifdef KERNEL_LATENCY_PROBES
+		uint64_t probeStart = LatencyProbes::begin();
+#endif // KERNEL_LATENCY_PROBES
+		if (!IsrRequests::isEmpty()) //apply interrupts requests first, they may elect another task
+		{
+			// kernel critical section leaves system timer enabled, requests also touch lists used by tick
+			uint8_t level = core::Core::vectorManager.lockInterruptsHigherThan(s_systemPriority);
+			IsrRequests::applyPending();
+			core::Core::vectorManager.unlockInterruptsHigherThan(level);
+		}
+#ifdef KERNEL_CHECK_INVARIANTS
+		{
+			// check before switching: a tick served once unmasked may elect another task, state is read again below
+			uint8_t level = core::Core::vectorManager.lockInterruptsHigherThan(s_systemPriority);
+			checkInvariants();
+			core::Core::vectorManager.unlockInterruptsHigherThan(level);
+		}
+#endif // KERNEL_CHECK_INVARIANTS
 		if (s_trigger != kernel::Scheduler::changeTaskTrigger::none) // avoid Spurious interrupt
 		{
 			Y_ASSERT(s_activeTask != nullptr);
@@ -256,9 +355,13 @@ namespace kernel
 			Y_ASSERT(!s_taskToStack->isStackCorrupted());
 			s_taskToStack->setStackPointer(stackPosition);
 			Y_ASSERT(s_taskToStack->m_stackUsage < (s_taskToStack->m_stackSize - 48)); //16 + 32 float
+#ifdef KERNEL_RUNTIME_STATS
+			RuntimeStats::onTaskSwitch(s_taskToStack, s_activeTask);
+#endif // KERNEL_RUNTIME_STATS
 
 			s_taskToStack = nullptr;
 			s_activeTask->m_state = kernel::TaskController::State::active;
+			s_timeSliceLeft = s_timeSlices[s_activeTask->m_priority]; // new quantum
 			Hooks::onTaskStartExec(s_activeTask);
 			s_trigger = kernel::Scheduler::changeTaskTrigger::none;
 		}
@@ -268,37 +371,105 @@ namespace kernel
 			s_activeTask->m_stackPointer = stackPosition;
 		}
 		scheduled = false;
+#ifdef KERNEL_LATENCY_PROBES
+		LatencyProbes::end(LatencyProbe::taskSwitch, probeStart);
+#endif // KERNEL_LATENCY_PROBES
 		return s_activeTask->m_stackPointer;
 	}
 
+#ifdef KERNEL_CHECK_INVARIANTS
+	void Scheduler::checkInvariants()
+	{
+		Y_ASSERT(s_activeTask != nullptr);
+		Y_ASSERT(s_ready.isConsistent());
+		Y_ASSERT(s_timers.isConsistent());
+		uint32_t ready = 0;
+		uint32_t timed = 0;
+		s_started.foreach([&](TaskController *task) {
+			bool inReady = s_ready.contain(task);
+			bool inTimers = s_timers.contain(task);
+			ready += inReady ? 1 : 0;
+			timed += inTimers ? 1 : 0;
+			Y_ASSERT(task->m_priority >= task->m_basePriority); // inheritance only raises priority
+			if (task == s_activeTask)
+			{
+				// elected task stays ready until switched in
+				Y_ASSERT(task->m_state == TaskController::State::active || (s_trigger != changeTaskTrigger::none && task->m_state == TaskController::State::ready));
+				Y_ASSERT(!inReady && !inTimers);
+				Y_ASSERT(task->m_waitingFor == nullptr);
+				return;
+			}
+			switch (task->m_state)
+			{
+			case TaskController::State::active:
+				Y_ASSERT(false); // only one task runs
+				break;
+			case TaskController::State::ready:
+				Y_ASSERT(inReady && !inTimers);
+				Y_ASSERT(task->m_waitingFor == nullptr);
+				break;
+			case TaskController::State::sleeping:
+				Y_ASSERT(!inReady && inTimers);
+				Y_ASSERT(task->m_waitingFor == nullptr);
+				break;
+			case TaskController::State::notStarted:
+				Y_ASSERT(false); // stopped tasks leave started list
+				break;
+			default: // waiting on an object, timer wheel holds it only for a timed wait
+				Y_ASSERT(!inReady);
+				Y_ASSERT(task->m_waitingFor != nullptr);
+				break;
+			}
+		});
+		Y_ASSERT(ready == s_ready.count()); // no task outside started list is scheduled
+		Y_ASSERT(timed == s_timers.count());
+	}
+#endif // KERNEL_CHECK_INVARIANTS
+
 	void Scheduler::systemTimerTick()
 	{
 		bool needSchedule = false;
-		s_ticks++;
-		while (!s_sleeping.isEmpty() && (s_sleeping.peekFirst()->m_wakeUpTimeStamp) <= s_ticks) //one task or more is waiting, let's see if waiting is over
+		bool timeSliceOver = consumeTimeSlice();
+		advanceTicks(1);
+#ifdef KERNEL_LATENCY_PROBES
+		uint64_t probeStart = LatencyProbes::begin(); // cycle clock is one period late until tick is counted
+#endif // KERNEL_LATENCY_PROBES
+		TaskController *expired;
+		while ((expired = s_timers.getExpired(s_ticks)) != nullptr) //one task or more reached its time stamp
 		{
-			needSchedule = true;
-			TaskController *readyTask = s_sleeping.getFirst();
-			Y_ASSERT(readyTask != nullptr);
-			readyTask->m_wakeUpTimeStamp = 0;
-			readyTask->m_state = kernel::TaskController::State::ready;
-			Y_ASSERT(!s_ready.contain(readyTask)); //new Ready task should not being already in ready list
-			s_ready.insert(readyTask, TaskController::priorityCompare);
-			Hooks::onTaskReady(readyTask);
-		}
-		while (!s_waiting.isEmpty() && (s_waiting.peekFirst()->m_wakeUpTimeStamp <= s_ticks))
-		{
-			TaskController *timeouted = s_waiting.getFirst();
-			Y_ASSERT(timeouted->m_waitingFor != nullptr);
-			timeouted->m_waitingFor->onTimeout(timeouted);
+			if (expired->m_state == kernel::TaskController::State::sleeping)
+			{
+				needSchedule = true;
+				expired->m_wakeUpTimeStamp = 0;
+				expired->m_state = kernel::TaskController::State::ready;
+				Y_ASSERT(!s_ready.contain(expired)); //new Ready task should not being already in ready list
+				s_ready.insert(expired);
+				Hooks::onTaskReady(expired);
+			}
+			else //timed wait on a kernel object is over
+			{
+				Y_ASSERT(expired->m_waitingFor != nullptr);
+				expired->m_waitingFor->onTimeout(expired);
+			}
 		}
 		if (needSchedule)
 			schedule(kernel::Scheduler::changeTaskTrigger::exitSleep);
+		if (timeSliceOver && s_trigger == kernel::Scheduler::changeTaskTrigger::none) // active task still running, share processor with its peers
+		{
+			if (!yield(kernel::Scheduler::changeTaskTrigger::timeSliceOver))
+				s_timeSliceLeft = s_timeSlices[s_activeTask->m_priority]; // nobody to share with, start a new quantum
+		}
+#ifdef KERNEL_LATENCY_PROBES
+		LatencyProbes::end(LatencyProbe::systemTick, probeStart);
+#endif // KERNEL_LATENCY_PROBES
 	}
 
 	void Scheduler::supervisorCall(ServiceCall::SvcNumber t_service, uint32_t *t_args)
 	{
-		uint32_t param0 = t_args[0], param1 = t_args[1], param2 = t_args[2];
+#ifdef KERNEL_LATENCY_PROBES
+		uint64_t probeStart = LatencyProbes::begin();
+#endif // KERNEL_LATENCY_PROBES
+		uint32_t param0 = t_args[0], param1 = t_args[1], param2 = t_args[2], param3 = t_args[3];
 		switch (t_service)
 		{
 		case ServiceCall::SvcNumber::startFirstTask:
@@ -325,6 +496,14 @@ namespace kernel
 			t_args[0] = sleep(param0);
 			break;
 
+		case ServiceCall::SvcNumber::sleepUntilTask:
+			t_args[0] = sleepUntil((static_cast<uint64_t>(param1) << 32) | param0);
+			break;
+
+		case ServiceCall::SvcNumber::yieldTask:
+			t_args[0] = yield(kernel::Scheduler::changeTaskTrigger::yield);
+			break;
+
 		case ServiceCall::SvcNumber::signalEvent:
 			t_args[0] = Event::kernelSignalEvent(reinterpret_cast<Event *>(param0));
 			break;
@@ -367,15 +546,146 @@ namespace kernel
 		case kernel::ServiceCall::SvcNumber::mutexRelease:
 			t_args[0] = Mutex::kernelReleaseMutex(reinterpret_cast<Mutex *>(param0));
 			break;
+		case kernel::ServiceCall::SvcNumber::ceilingMutexRelease:
+			t_args[0] = CeilingMutex::kernelRelease(reinterpret_cast<CeilingMutex *>(param0));
+			break;
+
+		case kernel::ServiceCall::SvcNumber::semaphoreTake:
+			t_args[0] = Semaphore::kernelTakeSemaphore(reinterpret_cast<Semaphore *>(param0), param1);
+			break;
+		case kernel::ServiceCall::SvcNumber::semaphoreGive:
+			t_args[0] = Semaphore::kernelGiveSemaphore(reinterpret_cast<Semaphore *>(param0), param1);
+			break;
+
+		case kernel::ServiceCall::SvcNumber::queueReserveSend:
+			t_args[0] = MessageQueueBase::kernelReserveSend(reinterpret_cast<MessageQueueBase *>(param0), param1);
+			break;
+		case kernel::ServiceCall::SvcNumber::queueWakeReceivers:
+			t_args[0] = MessageQueueBase::kernelWakeReceivers(reinterpret_cast<MessageQueueBase *>(param0));
+			break;
+		case kernel::ServiceCall::SvcNumber::queueReserveReceive:
+			t_args[0] = MessageQueueBase::kernelReserveReceive(reinterpret_cast<MessageQueueBase *>(param0), param1);
+			break;
+		case kernel::ServiceCall::SvcNumber::queueWakeSenders:
+			t_args[0] = MessageQueueBase::kernelWakeSenders(reinterpret_cast<MessageQueueBase *>(param0));
+			break;
+
+		case kernel::ServiceCall::SvcNumber::eventGroupWait:
+			t_args[0] = EventGroup::kernelWaitEventGroup(reinterpret_cast<EventGroup *>(param0), param1, param2, param3);
+			break;
+		case kernel::ServiceCall::SvcNumber::eventGroupSet:
+			t_args[0] = EventGroup::kernelSetEventGroup(reinterpret_cast<EventGroup *>(param0), param1);
+			break;
+
+		case kernel::ServiceCall::SvcNumber::notifyTask:
+			t_args[0] = Notification::kernelNotify(reinterpret_cast<TaskController *>(param0), param1, static_cast<NotifyAction>(param2));
+			break;
+		case kernel::ServiceCall::SvcNumber::waitNotification:
+			t_args[0] = Notification::kernelWaitNotification(reinterpret_cast<uint32_t *>(param0), param1 != 0, param2);
+			break;
+
+#ifdef KERNEL_RUNTIME_STATS
+		case kernel::ServiceCall::SvcNumber::runtimeStatsSnapshot:
+			t_args[0] = RuntimeStats::kernelSnapshot(reinterpret_cast<TaskStatistics *>(param0), param1);
+			break;
+		case kernel::ServiceCall::SvcNumber::runtimeStatsCpuLoad:
+			t_args[0] = RuntimeStats::kernelCpuLoad();
+			break;
+#endif // KERNEL_RUNTIME_STATS
+
+#ifdef KERNEL_LATENCY_PROBES
+		case kernel::ServiceCall::SvcNumber::latencySnapshot:
+			t_args[0] = LatencyProbes::kernelSnapshot(static_cast<LatencyProbe>(param0), reinterpret_cast<LatencyStatistics *>(param1));
+			break;
+		case kernel::ServiceCall::SvcNumber::latencyReset:
+			t_args[0] = LatencyProbes::kernelReset();
+			break;
+#endif // KERNEL_LATENCY_PROBES
 
 		default: //unknown Service call number
 			__BKPT(0);
 			break;
 		}
+#ifdef KERNEL_LATENCY_PROBES
+		LatencyProbes::end(LatencyProbe::serviceCall, probeStart);
+#endif // KERNEL_LATENCY_PROBES
+	}
+
+	void Scheduler::advanceTicks(uint32_t elapsed)
+	{
+		uint64_t ticks = s_ticks + elapsed;
+		s_ticks = ticks;
+		uint32_t sequence = s_tickSequence + 1;
+		s_publishedTicks[sequence & 1] = ticks; // copy readers do not use until sequence is published
+		__atomic_store_n(&s_tickSequence, sequence, __ATOMIC_RELEASE);
 	}
 
+	// a reader preempted by a tick sees a new sequence and reads again,
+	// a reader preempting a tick reads previous copy, which is left untouched
 	uint64_t Scheduler::getTicks()
 	{
-		return s_ticks;
+		uint32_t sequence;
+		uint64_t ticks;
+		do
+		{
+			sequence = __atomic_load_n(&s_tickSequence, __ATOMIC_ACQUIRE);
+			ticks = s_publishedTicks[sequence & 1];
+			__atomic_thread_fence(__ATOMIC_ACQUIRE);
+		} while (sequence != __atomic_load_n(&s_tickSequence, __ATOMIC_RELAXED));
+		return ticks;
+	}
+
+	// same retry scheme as getTicks, a period ended without its tick handled (interrupts masked or higher priority) is added by hand
+	uint64_t Scheduler::getCycles()
+	{
+		uint32_t sequence;
+		uint64_t ticks;
+		uint32_t sinceTick;
+		do
+		{
+			sequence = __atomic_load_n(&s_tickSequence, __ATOMIC_ACQUIRE);
+			ticks = s_publishedTicks[sequence & 1];
+			sinceTick = core::Core::systemTimer.cyclesSinceTick();
+			if (core::Core::systemTimer.isTickPending()) // read again, first read may be from previous period
+				sinceTick = core::Core::systemTimer.cyclesSinceTick() + s_cyclesPerTick;
+			__atomic_thread_fence(__ATOMIC_ACQUIRE);
+		} while (sequence != __atomic_load_n(&s_tickSequence, __ATOMIC_RELAXED));
+		return ticks * s_cyclesPerTick + sinceTick;
+	}
+
+	void Scheduler::idleTaskFunction(uint32_t)
+	{
+		while (true)
+			idleSuppressTicks();
+	}
+
+	// idle task is privileged, it can mask interrupts without service call
+	void Scheduler::idleSuppressTicks()
+	{
+		core::Core::vectorManager.lockAllInterrupts();
+		if (!s_ready.isEmpty()) // a task became ready meanwhile, let it run
+		{
+			core::Core::vectorManager.enableAllInterrupts();
+			return;
+		}
+		uint64_t now = s_ticks;
+		uint64_t idleTicks = s_timers.nextExpiry(now) - now;
+		uint32_t maxTicks = core::Core::systemTimer.maxOneShotTicks();
+		if (idleTicks < config::ticklessMinIdleTicks || maxTicks < config::ticklessMinIdleTicks) // not worth reprogramming timer
+		{
+			core::Core::vectorManager.enableAllInterrupts();
+			__WFI();
+			return;
+		}
+		if (idleTicks > maxTicks)
+			idleTicks = maxTicks;
+		core::Core::systemTimer.startOneShot(static_cast<uint32_t>(idleTicks));
+		__DSB();
+		__WFI(); // wake up on pending interrupt even if masked
+		__ISB();
+		// no timeout is due before the one shot end, skipped ticks only need to be counted,
+		// last one is counted by the pending tick interrupt once interrupts are enabled
+		advanceTicks(core::Core::systemTimer.stopOneShot());
+		core::Core::vectorManager.enableAllInterrupts();
 	}
 }	//End namespace kernel
@@ -29,9 +29,18 @@ Software without prior written authorization from Florian GERARD
 #pragma once
 
 #include "Event.hpp"
+#include "EventGroup.hpp"
+#include "IsrRequests.hpp"
+#include "LatencyProbes.hpp"
 #include "Mutex.hpp"
+#include "ReadyQueue.hpp"
+#include "RuntimeStats.hpp"
+#include "MessageQueue.hpp"
+#include "Notification.hpp"
+#include "Semaphore.hpp"
 #include "ServiceCall.hpp"
 #include "Task.hpp"
+#include "TimerWheel.hpp"
 #include <array>
 
 #include "yggdrasil/framework/Assertion.hpp"
@@ -48,15 +57,28 @@ namespace core
 }
 namespace kernel
 {
+	template<uint32_t StackSize, uint32_t Slots>
+	class WorkQueue;
+
 	using namespace core::interfaces;
 	class Scheduler
 	{
 		friend class ServiceCall;
 		friend class Api;
-		friend class SystemView;
+		friend class Trace;
 		friend class TaskController;
 		friend class Mutex;
+		friend class CeilingMutex;
+		friend class Semaphore;
+		friend class MessageQueueBase;
+		friend class IsrRequests;
+		friend class EventGroup;
+		friend class Notification;
+		friend class RuntimeStats;
+		friend class LatencyProbes;
 		friend class Event;
+		template<uint32_t StackSize, uint32_t Slots>
+		friend class WorkQueue;
 		friend class ::core::Core;
 
 	  private:
@@ -72,7 +94,22 @@ namespace kernel
 			wakeByMutex = 7,
 			eventTimeout = 8,
 			mutexTimeout = 9,
-			none = 20,
+			yield = 10,
+			timeSliceOver = 11,
+			waitForSemaphore = 12,
+			wakeBySemaphore = 13,
+			semaphoreTimeout = 14,
+			waitForQueue = 15,
+			wakeByQueue = 16,
+			queueTimeout = 17,
+			waitForEventGroup = 18,
+			wakeByEventGroup = 19,
+			eventGroupTimeout = 20,
+			waitForNotification = 21,
+			wakeByNotification = 22,
+			notificationTimeout = 23,
+			priorityRestored = 24,
+			none = 0xFF,
 		};
 
 		static void setupKernel(uint8_t systemPriority);
@@ -90,10 +127,11 @@ namespace kernel
 		static bool s_interruptInstalled;
 
 		/* Tasks Lists */
-		static ReadyList s_ready;
-		static SleepingList s_sleeping;
+		static ReadyQueue s_ready;
+#ifdef KERNEL_STARTED_LIST
 		static StartedList s_started;
-		static WaitableList s_waiting;
+#endif // KERNEL_STARTED_LIST
+		static TimerWheel s_timers; // sleeping tasks and timed waits
 
 		/* Task Related Variables */
 		static volatile changeTaskTrigger s_trigger;
@@ -103,10 +141,16 @@ namespace kernel
 		static volatile uint8_t s_lockLevel; // store the level of lock before critical section enters
 		static volatile bool s_isKernelLocked; // indicates if the kernel is in a critical section mode 
 		static uint32_t s_sysTickFreq;
+		static uint32_t s_coreFrequency; // core cycles per second, read at kernel start
+		static uint32_t s_cyclesPerTick;
+		static std::array<uint32_t, config::priorityLevels> s_timeSlices; // round robin quantum of each priority level, in ticks
+		static uint32_t s_timeSliceLeft; // ticks left to active task before yielding to a task of same priority, 0 if not sliced
 
 		/* Scheduler misc */
 		static bool s_schedulerStarted;
-		volatile static uint64_t s_ticks;
+		volatile static uint64_t s_ticks; // kernel time, read as is only from kernel context
+		static volatile uint64_t s_publishedTicks[2]; // copies of kernel time for getTicks, newest one at index s_tickSequence & 1
+		static volatile uint32_t s_tickSequence; // incremented each time kernel time is published
 
 		/****************************************************FUNCTIONS*************************************************/
 
@@ -131,13 +175,34 @@ namespace kernel
 		 * Look at ready task to see if a context switching is needed
 		 ***/
 		static bool schedule(changeTaskTrigger trigger);
+		/*Put active task at the end of its priority level if a task of same or higher priority is ready*/
+		static bool yield(changeTaskTrigger trigger);
+		/*Put back active task in ready tasks and elect first ready task*/
+		static void preemptActiveTask(changeTaskTrigger trigger);
+		/*Change running priority of a task, keeping ready tasks ordered*/
+		static void changePriority(TaskController *task, uint32_t priority);
+		/*Count a tick on active task quantum, return true when quantum is over*/
+		static bool consumeTimeSlice();
+		/*Quantum of task ran out while it held a ceiling mutex, it has to rotate once released*/
+		static bool isTimeSliceOverdue(TaskController *task)
+		{
+			return task == s_activeTask && s_timeSliceLeft == 0 && s_timeSlices[task->m_priority] != 0;
+		}
 		static void asmPendSv();
 		static void asmSvcHandler();
 		/*Stop a Task*/
 		static bool stopTask(TaskController *task);
 		//function to sleep a task for a number of ms
 		static bool sleep(uint32_t ms);
+		//sleep a task until an absolute tick, return false without sleeping if tick is already reached
+		static bool sleepUntil(uint64_t tick);
+		//put active task in timer wheel until tick
+		static bool enterSleep(uint64_t tick);
 		static volatile uint32_t* taskSwitch(uint32_t *stackPosition);
+#ifdef KERNEL_CHECK_INVARIANTS
+		//walk started tasks and kernel lists, assert when a task state does not match the lists holding it
+		static void checkInvariants();
+#endif // KERNEL_CHECK_INVARIANTS
 		//set pendSv, trigger context switch
 		static void setPendSv(changeTaskTrigger trigger);
 		//static void checkStack();
@@ -146,13 +211,20 @@ namespace kernel
 		//static void wait(interfaces::IWaitable *waitable);
 		//systick handler
 		static void systemTimerTick();
+		//count elapsed ticks and publish new kernel time for getTicks
+		static void advanceTicks(uint32_t elapsed);
 		static void svcBootstrap();
 		//Svc handler, redirect svc call to the right function
 		static void supervisorCall(ServiceCall::SvcNumber t_service, uint32_t *t_args);
 
 	private:
-		//Function of Idle Task (NOP when NDEBUG is defined, WFI when release)
+		//Function of Idle Task when KERNEL_TICKLESS is defined, core idle function is used otherwise
 		static void idleTaskFunction(uint32_t);
+		//stop periodic tick until next timeout and sleep, used by idle task in tickless mode
+		static void idleSuppressTicks();
+		//read kernel time from any context, lock free and never torn
 		static uint64_t getTicks();
+		//core cycles since kernel time origin, kernel time refined with current tick period progress, from any context
+		static uint64_t getCycles();
 	};
 } // namespace kernel
@@ -0,0 +1,158 @@
+/*MIT License
+
+Copyright (c) 2019 Florian GERARD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Except as contained in this notice, the name of Florian GERARD shall not be used 
+in advertising or otherwise to promote the sale, use or other dealings in this 
+Software without prior written authorization from Florian GERARD
+
+*/
+
+#include "Semaphore.hpp"
+#include "Hooks.hpp"
+#include "IsrRequests.hpp"
+#include "Scheduler.hpp"
+#include "core/Core.hpp"
+
+
+namespace kernel
+{
+	int16_t Semaphore::take(uint32_t timeout)
+	{
+		Y_ASSERT(Scheduler::inThreadMode());
+		if (tryTake())
+			return 1;
+		return supervisorCallTakeSemaphore(this, timeout);
+	}
+
+	// count is only decremented with exclusive access, an exception in between makes it fail and retry
+	bool Semaphore::tryTake()
+	{
+		uint32_t available = m_count;
+		while (available != 0)
+		{
+			if (__atomic_compare_exchange_n(&m_count, &available, available - 1, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+			{
+				Hooks::onSemaphoreTake(this, Scheduler::s_activeTask);
+				return true;
+			}
+		}
+		return false;
+	}
+
+	bool Semaphore::give(uint32_t units)
+	{
+		return supervisorCallGiveSemaphore(this, units);
+	}
+
+	bool Semaphore::giveFromIsr(uint32_t units)
+	{
+		return IsrRequests::post(IsrRequests::Type::giveSemaphore, this, units);
+	}
+
+	uint32_t Semaphore::count()
+	{
+		return m_count;
+	}
+
+	bool Semaphore::someoneWaiting()
+	{
+		return !m_waiting.isEmpty();
+	}
+
+	// A task want a unit, wait for it if none is available
+	int16_t Semaphore::kernelTakeSemaphore(Semaphore *semaphore, uint32_t duration)
+	{
+		Y_ASSERT(Scheduler::s_activeTask != nullptr);
+		if (semaphore->m_count != 0) // given since fast path failed
+		{
+			semaphore->m_count = semaphore->m_count - 1;
+			Hooks::onSemaphoreTake(semaphore, Scheduler::s_activeTask);
+			return 1;
+		}
+		semaphore->m_waiting.insert(Scheduler::s_activeTask, TaskController::priorityCompare);
+		if (duration > 0)
+		{
+			Scheduler::s_activeTask->m_wakeUpTimeStamp = Scheduler::s_ticks + duration;
+			Scheduler::s_timers.insert(Scheduler::s_activeTask, Scheduler::s_ticks);
+		}
+		Scheduler::s_activeTask->m_waitingFor = semaphore;
+		Scheduler::s_activeTask->m_state = kernel::TaskController::State::waitingSemaphore;
+		Scheduler::s_taskToStack = Scheduler::s_activeTask;
+		Scheduler::s_activeTask = Scheduler::s_ready.getFirst();
+		Hooks::onSemaphoreWait(semaphore, Scheduler::s_taskToStack, duration);
+		Scheduler::setPendSv(kernel::Scheduler::changeTaskTrigger::waitForSemaphore);
+		return 1; // used to return from interrupt, overwritten on timeout
+	}
+
+	bool Semaphore::kernelGiveSemaphore(Semaphore *semaphore, uint32_t units)
+	{
+		Y_ASSERT(semaphore != nullptr);
+		Hooks::onSemaphoreGive(semaphore, units);
+		bool woken = false;
+		while (units > 0 && !semaphore->m_waiting.isEmpty()) // hand units straight to waiters
+		{
+			TaskController *newReadyTask = semaphore->m_waiting.getFirst();
+			Y_ASSERT(!Scheduler::s_ready.contain(newReadyTask)); //If the semaphore ready task is already in ready list, we have a problem
+			newReadyTask->m_waitingFor = nullptr;
+			semaphore->stopWait(newReadyTask);
+			Scheduler::s_ready.insert(newReadyTask);
+			newReadyTask->m_state = kernel::TaskController::State::ready;
+			Hooks::onTaskReady(newReadyTask);
+			Hooks::onSemaphoreTake(semaphore, newReadyTask);
+			units--;
+			woken = true;
+		}
+		bool result = true;
+		if (units > semaphore->m_maxCount - semaphore->m_count)
+		{
+			units = semaphore->m_maxCount - semaphore->m_count;
+			result = false;
+		}
+		semaphore->m_count = semaphore->m_count + units;
+		if (woken)
+			Scheduler::schedule(kernel::Scheduler::changeTaskTrigger::wakeBySemaphore);
+		return result;
+	}
+
+	void Semaphore::stopWait(TaskController *task)
+	{
+		if (Scheduler::s_timers.remove(task))
+			task->m_wakeUpTimeStamp = 0;
+	}
+
+	void Semaphore::onTimeout(TaskController *task)
+	{
+		Y_ASSERT(task->m_waitingFor == this);
+		m_waiting.remove(task);
+		task->m_waitingFor = nullptr; //the task is no more waiting for semaphore
+		task->setReturnValue(static_cast<int16_t>(-1)); // timeout code
+		task->m_wakeUpTimeStamp = 0;
+		Scheduler::s_ready.insert(task);
+		task->m_state = kernel::TaskController::State::ready;
+		Hooks::onSemaphoreTimeout(this, task);
+		Hooks::onTaskReady(task);
+		Scheduler::schedule(kernel::Scheduler::changeTaskTrigger::semaphoreTimeout);
+	}
+
+	Semaphore::SupervisorCallTakeSemaphore Semaphore::supervisorCallTakeSemaphore = core::Core::supervisorCall<ServiceCall::SvcNumber::semaphoreTake, int16_t, Semaphore*, uint32_t>;
+	Semaphore::SupervisorCallGiveSemaphore Semaphore::supervisorCallGiveSemaphore = core::Core::supervisorCall<ServiceCall::SvcNumber::semaphoreGive, bool, Semaphore*, uint32_t>;
+} // End namespace kernel
@@ -0,0 +1,97 @@
+/*MIT License
+
+Copyright (c) 2019 Florian GERARD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Except as contained in this notice, the name of Florian GERARD shall not be used 
+in advertising or otherwise to promote the sale, use or other dealings in this 
+Software without prior written authorization from Florian GERARD
+
+*/
+
+#pragma once
+
+#include <cstdint>
+
+#include "Task.hpp"
+#include "ServiceCall.hpp"
+#include "yggdrasil/interfaces/IWaitable.hpp"
+
+
+namespace kernel
+{
+	/* Counting semaphore
+	 * waiters are served by priority, taking an available unit does not call kernel */
+	class Semaphore : public interfaces::IWaitable
+	{
+		friend class Scheduler;
+		friend class IsrRequests;
+	public:
+
+		constexpr Semaphore(uint32_t initialCount = 0, uint32_t maxCount = UINT32_MAX, const char *name = nullptr) :
+			m_waiting(), m_count(initialCount), m_maxCount(maxCount), m_name(name)
+		{
+		}
+
+		/* take one unit, wait for it if none is available
+		 * -timeout specify a time in ms to wait for a unit, 0 for no timeout
+		 * return 1 if success, -1 if timeout*/
+		int16_t take(uint32_t timeout = 0);
+
+		// take one unit if available, never wait
+		bool tryTake();
+
+		/* give units, each one is handed to a waiter by priority order, left ones are counted
+		 * every woken waiter is handled in a single scheduling pass
+		 * return false if count would exceed maximum, exceeding units are dropped*/
+		bool give(uint32_t units = 1);
+
+		/* give units from an interrupt handler, applied by kernel once interrupts are done
+		 * return false if too many interrupt requests are pending*/
+		bool giveFromIsr(uint32_t units = 1);
+
+		uint32_t count();
+
+		bool someoneWaiting();
+
+	private:
+		EventList m_waiting;
+		volatile uint32_t m_count;
+		const uint32_t m_maxCount;
+		const char *m_name;
+
+		static int16_t kernelTakeSemaphore(Semaphore *semaphore, uint32_t duration);
+		static bool kernelGiveSemaphore(Semaphore *semaphore, uint32_t units);
+		void stopWait(TaskController *task) final;
+		void onTimeout(TaskController *task) final;
+
+		// call kernel to wait for a unit
+		//@return int16_t, 1 if success, -1 if timeout
+		//@params pointer to semaphore, optional timeout (0 to disable)
+		using SupervisorCallTakeSemaphore = int16_t(&)(Semaphore*, uint32_t);
+		static SupervisorCallTakeSemaphore& supervisorCallTakeSemaphore;
+
+		// call kernel to give units
+		//@return bool, true if success, false if maximum count was reached
+		//@params pointer to semaphore, number of units
+		using SupervisorCallGiveSemaphore = bool(&)(Semaphore*, uint32_t);
+		static SupervisorCallGiveSemaphore& supervisorCallGiveSemaphore;
+	};
+} // namespace kernel
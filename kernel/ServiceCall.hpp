@@ -52,12 +52,29 @@ namespace kernel
 			startTask,
 			stopTask,
 			sleepTask,
+			sleepUntilTask,
 			signalEvent,
 			waitEvent,
 			enterCriticalSection,
 			exitCriticalSection,
 			mutexLock,
 			mutexRelease,
+			ceilingMutexRelease,
+			yieldTask,
+			semaphoreTake,
+			semaphoreGive,
+			queueReserveSend,
+			queueWakeReceivers,
+			queueReserveReceive,
+			queueWakeSenders,
+			eventGroupWait,
+			eventGroupSet,
+			notifyTask,
+			waitNotification,
+			runtimeStatsSnapshot,
+			runtimeStatsCpuLoad,
+			latencySnapshot,
+			latencyReset,
 		};
 	};
 }
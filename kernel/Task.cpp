@@ -32,6 +32,28 @@
 
 namespace kernel {
 
+// per task RAM report on 32 bits cores (Task::ramOverhead): 64 bytes of control block with 16 bytes of links (ready or waiting, timer), first release used 68
+// options add their own fields on top of it, the bound follows them so every build is checked
+constexpr uint32_t optionBytes = 0
+#ifdef KDEBUG
+		+ 2 * sizeof(void*) + sizeof(uint32_t) // list kept in both links, stack usage
+#endif // KDEBUG
+#ifdef KERNEL_STARTED_LIST
+		+ sizeof(framework::DualLinkNode<TaskController, StartedList>)
+#endif // KERNEL_STARTED_LIST
+#ifdef KERNEL_RUNTIME_STATS
+		+ 2 * sizeof(uint64_t) + 2 * sizeof(uint32_t)
+#endif // KERNEL_RUNTIME_STATS
+#ifdef KERNEL_TRACE
+		+ sizeof(uint8_t)
+#endif // KERNEL_TRACE
+#ifdef KERNEL_LATENCY_PROBES
+		+ sizeof(uint64_t)
+#endif // KERNEL_LATENCY_PROBES
+		;
+constexpr uint32_t paddingBytes = optionBytes != 0 ? sizeof(uint32_t) : 0; // option fields may leave an odd count of words before a 64 bits field
+static_assert(sizeof(void*) != 4 || sizeof(TaskController) <= (64 + optionBytes + paddingBytes + 7) / 8 * 8, "task control block grew, check links sharing and field packing");
+
 TaskController::StartTaskStub TaskController::startTaskStub = core::Core::supervisorCall<ServiceCall::SvcNumber::startTask, bool, TaskController*>;
 TaskController::StopTaskStub TaskController::stopTaskStub = core::Core::supervisorCall<ServiceCall::SvcNumber::stopTask, bool, TaskController*>;
 
@@ -70,7 +92,10 @@ bool TaskController::start(TaskFunc function, bool isPrivilegied, uint32_t prior
 	m_stackPointer[0] = 0xFFFFFFFD;	//LR, return from exception, 8 Word Stack Length (no floating point), return in thread mode, use PSP
 	if (!Scheduler::s_interruptInstalled)
 		Scheduler::installKernelInterrupt();
-	m_priority = priority;
+	Y_ASSERT(priority < config::priorityLevels);
+	m_priority = (priority < config::priorityLevels) ? priority : config::priorityLevels - 1; // clamp to highest level
+	m_basePriority = m_priority;
+	m_name = name;
 	startTaskStub(this);
 	return true;
 }
@@ -28,29 +28,58 @@
 #pragma once
 #include <cstdint>
 
+#include "Config.hpp"
 #include "ServiceCall.hpp"
 #include "yggdrasil/framework/DualLinkedList.hpp"
 #include "yggdrasil/interfaces/IWaitable.hpp"
 
 namespace kernel {
 class TaskController;
+class Mutex;
+class CeilingMutex;
 
+/*A task is either ready or waiting on a kernel object, never both, so ready and waiting lists share the same links
+ * a timed wait also puts the task in timer wheel, timer links stay separate*/
+class StateLink;
+
+#ifdef KERNEL_STARTED_LIST
 class StartedList: public framework::DualLinkedList<TaskController, StartedList> {
 };
-class ReadyList: public framework::DualLinkedList<TaskController, ReadyList> {
+#endif // KERNEL_STARTED_LIST
+class ReadyList: public framework::DualLinkedList<TaskController, StateLink> {
+};
+class TimerList: public framework::DualLinkedList<TaskController, TimerList> {
 };
-class SleepingList: public framework::DualLinkedList<TaskController, SleepingList> {
+class EventList: public framework::DualLinkedList<TaskController, StateLink> {
 };
-class WaitableList: public framework::DualLinkedList<TaskController, WaitableList> {
+class OwnedMutexList: public framework::DualLinkedHead<Mutex, OwnedMutexList> {
 };
-class EventList: public framework::DualLinkedList<TaskController, EventList> {
+
+/*How a notification value updates the value of the notified task*/
+enum class NotifyAction : uint8_t {
+	setBits, // or value with task value
+	increment, // add value to task value
+	overwrite, // replace task value
 };
 
-class TaskController: public framework::DualLinkNode<TaskController, StartedList>, public framework::DualLinkNode<TaskController, ReadyList>, public framework::DualLinkNode<TaskController, SleepingList>, public framework::DualLinkNode<TaskController, WaitableList>, public framework::DualLinkNode<TaskController, EventList> {
+class TaskController:
+#ifdef KERNEL_STARTED_LIST
+		public framework::DualLinkNode<TaskController, StartedList>,
+#endif // KERNEL_STARTED_LIST
+		public framework::DualLinkNode<TaskController, StateLink>, public framework::DualLinkNode<TaskController, TimerList> {
 	friend class Scheduler;
 	friend class Event;
 	friend class Mutex;
-	friend class SystemView;
+	friend class CeilingMutex;
+	friend class Semaphore;
+	friend class MessageQueueBase;
+	friend class EventGroup;
+	friend class Notification;
+	friend class RuntimeStats;
+	friend class LatencyProbes;
+	friend class ReadyQueue;
+	friend class TimerWheel;
+	friend class Trace;
 public:
 
 	using TaskFunc = void (*)(uint32_t);
@@ -59,16 +88,20 @@ public:
 
 	bool start(TaskFunc function, bool isPrivilegied, uint32_t taskPriority, uint32_t parameter, const char *name);
 	bool isStackCorrupted();
+	/*Update notification value of the task, wake it up if it waits for a notification*/
+	bool notify(uint32_t value, NotifyAction action);
+	/*Same as notify from an interrupt handler, return false if too many interrupt requests are pending*/
+	bool notifyFromIsr(uint32_t value, NotifyAction action);
 	static StartTaskStub &startTaskStub;
 	static StopTaskStub &stopTaskStub;
 	static void taskWrapper(TaskController &task, TaskFunc func, uint32_t parameter);
 	static void taskFinished();
 
-	enum class State : uint32_t {
-		sleeping = 0, active = 1, waitingEvent = 2, notStarted = 3, ready = 4, waitingMutex = 5,
+	enum class State : uint8_t {
+		sleeping = 0, active = 1, waitingEvent = 2, notStarted = 3, ready = 4, waitingMutex = 5, waitingSemaphore = 6, waitingQueue = 7, waitingEventGroup = 8, waitingNotification = 9,
 	};
 	constexpr TaskController(uint32_t *stack, uint32_t stackSize) :
-			m_stackPointer(nullptr), m_stackOrigin(stack), m_stackSize(stackSize), m_wakeUpTimeStamp(0), m_waitingFor(nullptr), m_priority(0), m_state(State::notStarted), m_name(nullptr) {
+			m_stackPointer(nullptr), m_stackOrigin(stack), m_stackSize(stackSize), m_waitingFor(nullptr), m_ownedMutexes(), m_waitValue(0), m_notificationValue(0), m_name(nullptr), m_ceilings(nullptr), m_priority(0), m_basePriority(0), m_waitOptions(0), m_notificationPending(false), m_state(State::notStarted), m_wakeUpTimeStamp(0) {
 	}
 
 private:
@@ -76,40 +109,37 @@ private:
 	uint32_t *const m_stackOrigin;
 	const uint32_t m_stackSize;
 
-	volatile uint32_t m_wakeUpTimeStamp;
 	interfaces::IWaitable *volatile m_waitingFor = nullptr;
-	uint32_t m_priority;
-	State m_state;
+	OwnedMutexList m_ownedMutexes; // mutexes locked by the task and waited for by others, head only
+	uint32_t m_waitValue; // value the task is waiting for, meaning depends on waited object
+	uint32_t m_notificationValue; // kept apart from wait fields, it is updated while the task waits on anything
 	const char *m_name;
+	CeilingMutex *m_ceilings; // innermost ceiling mutex held, it links outer ones
+	// byte fields packed in a single word, priorities are below config::priorityLevels
+	uint8_t m_priority; // running priority, may be raised by priority inheritance
+	uint8_t m_basePriority; // priority given at start
+	uint8_t m_waitOptions :7; // options of current wait, meaning depends on waited object
+	uint8_t m_notificationPending :1; // notified since last notification wait
+	State m_state;
 #ifdef KDEBUG
 		uint32_t m_stackUsage; // used to measure the usage of task's stack
 #endif // KDEBUG
+	volatile uint64_t m_wakeUpTimeStamp; // absolute tick, 64 bits so it never wraps, after 32 bits fields so they need no padding
+#ifdef KERNEL_RUNTIME_STATS
+	uint64_t m_runCycles = 0; // core cycles spent running, charged at each switch
+	uint64_t m_maxRunCycles = 0;
+	uint32_t m_switchCount = 0;
+	uint32_t m_preemptionCount = 0;
+#endif // KERNEL_RUNTIME_STATS
+#ifdef KERNEL_TRACE
+	uint8_t m_traceId = 0; // task id in trace records, given at start
+#endif // KERNEL_TRACE
+#ifdef KERNEL_LATENCY_PROBES
+	uint64_t m_readyCycles = 0; // cycle clock when made ready, 0 once running
+#endif // KERNEL_LATENCY_PROBES
 
 	void stop();
 
-	/*Compare two Task timestamps
-	 * if base task was running after compared result is 1
-	 * if compared was running before base result is -1
-	 * if timestamps are the same
-	 * 		if base is higher priority result is -1
-	 * 		if compared is higher priority result is 1
-	 * 		else result is 0								*/
-	static int8_t sleepCompare(TaskController *base, TaskController *compared) {
-		if (base->m_wakeUpTimeStamp > compared->m_wakeUpTimeStamp)
-			return 1;
-		if (base->m_wakeUpTimeStamp < compared->m_wakeUpTimeStamp)
-			return -1;
-		if (base->m_wakeUpTimeStamp == compared->m_wakeUpTimeStamp) {
-			if (base->m_priority > compared->m_priority)
-				return -1;
-			if (base->m_priority < compared->m_priority)
-				return 1;
-			if (base->m_priority == compared->m_priority)
-				return 0;
-		}
-		return 0;
-	}
-
 	/*Compare two tasks
 	 * If base Task has higher priority (higher number) result is -1
 	 * If priorities are equals result is 0
@@ -125,7 +155,7 @@ private:
 	}
 
 	void setReturnValue(uint32_t value) {
-		auto ctrl = *(m_stackPointer + 8);
+		uint32_t ctrl = *(m_stackPointer + 1);
 		if ((ctrl & 0b100) == 0) // check bit #2 of control to know if floating point is active or not
 			*(reinterpret_cast<volatile uint32_t*>(m_stackPointer + 10)) = value;
 		else
@@ -150,6 +180,7 @@ private:
 
 template<uint32_t StackSize>
 class Task {
+	friend class RuntimeStats;
 public:
 	constexpr Task<StackSize>() :
 			data(m_stack, StackSize) {
@@ -157,6 +188,16 @@ public:
 	bool start(TaskController::TaskFunc function, bool isPrivilegied, uint32_t taskPriority, uint32_t parameter = 0, const char *name = "") {
 		return data.start(function, isPrivilegied, taskPriority, parameter, name);
 	}
+	bool notify(uint32_t value, NotifyAction action) {
+		return data.notify(value, action);
+	}
+	bool notifyFromIsr(uint32_t value, NotifyAction action) {
+		return data.notifyFromIsr(value, action);
+	}
+	//@return RAM used by the task besides its stack
+	static constexpr uint32_t ramOverhead() {
+		return sizeof(Task<StackSize>) - sizeof(m_stack);
+	}
 
 private:
 	uint32_t m_stack[StackSize]__attribute__((aligned(4)));
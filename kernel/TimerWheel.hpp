@@ -0,0 +1,157 @@
+/*MIT License
+
+Copyright (c) 2019 Florian GERARD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Except as contained in this notice, the name of Florian GERARD shall not be used 
+in advertising or otherwise to promote the sale, use or other dealings in this 
+Software without prior written authorization from Florian GERARD
+
+*/
+
+#pragma once
+
+#include <cstdint>
+
+#include "Config.hpp"
+#include "Task.hpp"
+#include "yggdrasil/framework/Assertion.hpp"
+
+namespace kernel
+{
+	/* Hashed timing wheel holding every task with a wake up time stamp (sleeping tasks and timed waits)
+	 * a task is stored unsorted in slot (wake up tick % slots) so arming and cancelling are constant time,
+	 * each tick only visits the slot of the current tick, tasks of later revolutions are left in place */
+	class TimerWheel
+	{
+	public:
+		constexpr TimerWheel() : m_slots(), m_count(0)
+		{
+		}
+
+		// arm task timeout at its wake up time stamp, a time stamp already reached expires on next tick
+		void insert(TaskController *task, uint64_t now)
+		{
+			Y_ASSERT(task != nullptr);
+			if (task->m_wakeUpTimeStamp <= now)
+				task->m_wakeUpTimeStamp = now + 1;
+			m_slots[slot(task->m_wakeUpTimeStamp)].insertEnd(task);
+			m_count++;
+		}
+
+		// cancel task timeout, return false if task was not armed
+		bool remove(TaskController *task)
+		{
+			if (task == nullptr || !m_slots[slot(task->m_wakeUpTimeStamp)].remove(task))
+				return false;
+			m_count--;
+			return true;
+		}
+
+		bool contain(TaskController *task)
+		{
+			if (task == nullptr)
+				return false;
+			return TimerLink::isLinked(task); // timer links are only used by the wheel
+		}
+
+		/* remove and return a task whose time stamp is reached at tick now, nullptr if none left
+		 * tasks of later revolutions met on the way are moved to the slot end so repeated calls visit them once */
+		TaskController *getExpired(uint64_t now)
+		{
+			TimerList &current = m_slots[slot(now)];
+			uint32_t toVisit = current.count();
+			while (toVisit-- > 0)
+			{
+				TaskController *task = current.getFirst();
+				if (task->m_wakeUpTimeStamp <= now)
+				{
+					m_count--;
+					return task;
+				}
+				current.insertEnd(task);
+			}
+			return nullptr;
+		}
+
+		/* earliest time stamp armed, UINT64_MAX if none
+		 * looks one revolution ahead of now then falls back to a full scan, only meant for idle time */
+		uint64_t nextExpiry(uint64_t now)
+		{
+			if (m_count == 0)
+				return UINT64_MAX;
+			for (uint64_t tick = now + 1; tick <= now + config::timerWheelSlots; tick++)
+			{
+				for (TaskController *task = m_slots[slot(tick)].peekFirst(); task != nullptr; task = TimerLink::next(task))
+				{
+					if (task->m_wakeUpTimeStamp <= tick)
+						return tick;
+				}
+			}
+			uint64_t earliest = UINT64_MAX;
+			for (uint32_t i = 0; i < config::timerWheelSlots; i++)
+			{
+				for (TaskController *task = m_slots[i].peekFirst(); task != nullptr; task = TimerLink::next(task))
+				{
+					if (task->m_wakeUpTimeStamp < earliest)
+						earliest = task->m_wakeUpTimeStamp;
+				}
+			}
+			return earliest;
+		}
+
+		bool isEmpty()
+		{
+			return m_count == 0;
+		}
+
+		uint32_t count()
+		{
+			return m_count;
+		}
+
+		// walk every slot: tasks sit in the slot of their time stamp, count is right
+		bool isConsistent()
+		{
+			uint32_t total = 0;
+			for (uint32_t i = 0; i < config::timerWheelSlots; i++)
+			{
+				for (TaskController *task = m_slots[i].peekFirst(); task != nullptr; task = TimerLink::next(task))
+				{
+					if (slot(task->m_wakeUpTimeStamp) != i)
+						return false;
+					total++;
+				}
+			}
+			return total == m_count;
+		}
+
+	private:
+		using TimerLink = framework::DualLinkNode<TaskController, TimerList>;
+
+		TimerList m_slots[config::timerWheelSlots];
+		uint32_t m_count;
+
+		static uint32_t slot(uint64_t tick)
+		{
+			return static_cast<uint32_t>(tick) & (config::timerWheelSlots - 1);
+		}
+	};
+} // namespace kernel
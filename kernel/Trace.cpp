@@ -0,0 +1,109 @@
+/*MIT License
+
+Copyright (c) 2019 Florian GERARD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Except as contained in this notice, the name of Florian GERARD shall not be used 
+in advertising or otherwise to promote the sale, use or other dealings in this 
+Software without prior written authorization from Florian GERARD
+
+*/
+
+#include "Trace.hpp"
+#include "Scheduler.hpp"
+
+#ifdef KERNEL_TRACE
+
+namespace kernel
+{
+	static_assert(sizeof(TraceRecord) == 12, "trace record layout is read by host tools");
+
+	TraceBuffer Trace::s_buffer = {magic, version, sizeof(TraceRecord), config::traceRecords, 0, 0, {}};
+	uint8_t Trace::s_lastTaskId = 0;
+
+	void Trace::record(TraceEvent event, TaskController *task, uint32_t argument)
+	{
+		write(event, taskId(task), argument);
+	}
+
+	void Trace::record(TraceEvent event, uint32_t argument)
+	{
+		write(event, taskId(Scheduler::s_activeTask), argument);
+	}
+
+	void Trace::record(TraceEvent event, const void *object)
+	{
+		write(event, taskId(Scheduler::s_activeTask), static_cast<uint32_t>(reinterpret_cast<uintptr_t>(object)));
+	}
+
+	void Trace::onTaskStart(TaskController *task)
+	{
+		if (task->m_traceId == 0) // ids are not reused, tasks past the 255th share id 255
+			task->m_traceId = (s_lastTaskId < UINT8_MAX) ? ++s_lastTaskId : UINT8_MAX;
+		write(TraceEvent::taskStart, task->m_traceId, task->m_basePriority);
+		const char *name = task->m_name;
+		if (name == nullptr)
+			return;
+		// 4 characters per record, last record padded with zeros
+		bool ended = false;
+		while (!ended)
+		{
+			uint32_t characters = 0;
+			for (uint32_t i = 0; i < 4; i++)
+			{
+				if (!ended && *name == '\0')
+					ended = true;
+				if (!ended)
+					characters |= static_cast<uint32_t>(static_cast<uint8_t>(*name++)) << (8 * i);
+			}
+			write(TraceEvent::taskName, task->m_traceId, characters);
+		}
+	}
+
+	void Trace::onKernelStart()
+	{
+		s_buffer.coreFrequency = Scheduler::s_coreFrequency;
+		write(TraceEvent::kernelStart, 0, 0);
+	}
+
+	void Trace::write(TraceEvent event, uint8_t task, uint32_t argument)
+	{
+		uint32_t index = __atomic_fetch_add(&s_buffer.written, 1, __ATOMIC_RELAXED);
+		TraceRecord &record = s_buffer.records[index & (config::traceRecords - 1)];
+		uint64_t now = Scheduler::getCycles();
+		record.timestampLow = static_cast<uint32_t>(now);
+		record.timestampHigh = static_cast<uint16_t>(now >> 32);
+		record.event = event;
+		record.task = task;
+		record.argument = argument;
+	}
+
+	const TraceBuffer &Trace::buffer()
+	{
+		return s_buffer;
+	}
+
+	uint8_t Trace::taskId(TaskController *task)
+	{
+		return (task != nullptr) ? task->m_traceId : 0;
+	}
+} // namespace kernel
+
+#endif // KERNEL_TRACE
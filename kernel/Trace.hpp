@@ -0,0 +1,126 @@
+/*MIT License
+
+Copyright (c) 2019 Florian GERARD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Except as contained in this notice, the name of Florian GERARD shall not be used 
+in advertising or otherwise to promote the sale, use or other dealings in this 
+Software without prior written authorization from Florian GERARD
+
+*/
+
+#pragma once
+
+#include <cstdint>
+
+#include "Config.hpp"
+
+
+namespace kernel
+{
+	class TaskController;
+
+	/* Kernel events recorded in trace, values are part of trace format read by tools/trace_decode.py*/
+	enum class TraceEvent : uint8_t
+	{
+		kernelStart = 0,
+		taskStart = 1, // argument: priority
+		taskName = 2, // argument: 4 characters of task name, sent after taskStart
+		taskStartExec = 3,
+		taskStopExec = 4,
+		taskClose = 5,
+		taskReady = 6,
+		taskSleep = 7, // argument: ticks
+		taskWaitEvent = 8, // argument: event
+		eventTrigger = 9, // argument: event
+		eventTimeout = 10, // argument: event
+		mutexLock = 11, // argument: mutex
+		mutexRelease = 12, // argument: mutex
+		mutexWait = 13, // argument: mutex
+		mutexTimeout = 14, // argument: mutex
+		semaphoreTake = 15, // argument: semaphore
+		semaphoreGive = 16, // argument: semaphore
+		semaphoreWait = 17, // argument: semaphore
+		semaphoreTimeout = 18, // argument: semaphore
+		queueSend = 19, // argument: queue
+		queueReceive = 20, // argument: queue
+		queueWait = 21, // argument: queue
+		queueTimeout = 22, // argument: queue
+		eventGroupSet = 23, // argument: mask
+		eventGroupWait = 24, // argument: event group
+		eventGroupTimeout = 25, // argument: event group
+		taskNotify = 26, // argument: value
+		notificationWait = 27, // argument: timeout
+		notificationTimeout = 28,
+	};
+
+	/* One trace record, 12 bytes*/
+	struct TraceRecord
+	{
+		uint32_t timestampLow; // cycle clock, low word
+		uint16_t timestampHigh; // cycle clock, bits 32 to 47
+		TraceEvent event;
+		uint8_t task; // trace id of task concerned, 0 if none
+		uint32_t argument;
+	};
+
+	/* Trace buffer as laid out in memory, dump it as a whole for tools/trace_decode.py*/
+	struct TraceBuffer
+	{
+		uint32_t magic;
+		uint16_t version;
+		uint16_t recordSize;
+		uint32_t capacity; // number of records
+		volatile uint32_t written; // records written since start, newest one at (written - 1) % capacity
+		uint32_t coreFrequency; // cycle clock frequency, set at kernel start
+		TraceRecord records[config::traceRecords];
+	};
+
+	/* Kernel event trace, built when KERNEL_TRACE is defined
+	 * kernel hooks write compact binary records in a RAM ring, oldest records are overwritten
+	 * a record slot is claimed atomically, hooks running in tasks, kernel or interrupts never lock each other */
+	class Trace
+	{
+	public:
+		static constexpr uint32_t magic = 0x43525459; // "YTRC"
+		static constexpr uint16_t version = 1;
+
+		// record an event about a task
+		static void record(TraceEvent event, TaskController *task, uint32_t argument = 0);
+		// record an event about active task
+		static void record(TraceEvent event, uint32_t argument = 0);
+		// record an event about a kernel object
+		static void record(TraceEvent event, const void *object);
+
+		// give task a trace id and record its name
+		static void onTaskStart(TaskController *task);
+		static void onKernelStart();
+
+		// trace buffer, for an application dumping it itself (e.g. over a serial link)
+		static const TraceBuffer &buffer();
+
+	private:
+		static TraceBuffer s_buffer;
+		static uint8_t s_lastTaskId;
+
+		static void write(TraceEvent event, uint8_t task, uint32_t argument);
+		static uint8_t taskId(TaskController *task);
+	};
+} // namespace kernel
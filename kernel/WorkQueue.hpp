@@ -0,0 +1,109 @@
+/*MIT License
+
+Copyright (c) 2019 Florian GERARD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Except as contained in this notice, the name of Florian GERARD shall not be used 
+in advertising or otherwise to promote the sale, use or other dealings in this 
+Software without prior written authorization from Florian GERARD
+
+*/
+
+#pragma once
+
+#include <cstdint>
+
+#include "Event.hpp"
+#include "Scheduler.hpp"
+#include "Task.hpp"
+#include "yggdrasil/framework/LockFreeRing.hpp"
+
+
+namespace kernel
+{
+	/* Deferred work queue, run interrupt bottom halves in a dedicated worker task
+	 * an interrupt posts a function and its context word, worker drains every posted item each time it wakes up
+	 * several posts before worker runs cost a single wake up
+	 * use one queue per worker priority */
+	template<uint32_t StackSize, uint32_t Slots = 16>
+	class WorkQueue
+	{
+	public:
+		using WorkFunction = void (*)(uint32_t);
+
+		constexpr WorkQueue(const char *name = nullptr) : m_items(), m_posted(false, name), m_signalPending(false), m_worker(), m_name(name)
+		{
+		}
+
+		// start worker task, works are run at given priority
+		bool start(uint32_t priority, bool isPrivilegied = true)
+		{
+			return m_worker.start(workerFunction, isPrivilegied, priority, static_cast<uint32_t>(reinterpret_cast<uintptr_t>(this)), m_name);
+		}
+
+		/* post a work, from an interrupt or a task
+		 * return false if queue is full, work is dropped,
+		 * or if an interrupt could not wake worker (interrupt requests full), work is kept and runs once a later post wakes worker*/
+		bool post(WorkFunction function, uint32_t context = 0)
+		{
+			Y_ASSERT(function != nullptr);
+			if (!m_items.push(WorkItem{function, context}))
+				return false;
+			if (__atomic_exchange_n(&m_signalPending, true, __ATOMIC_ACQ_REL)) //worker already signaled since it last woke up
+				return true;
+			if (Scheduler::inThreadMode()) //kernel call cannot be lost
+			{
+				m_posted.signal();
+				return true;
+			}
+			if (m_posted.signalFromIsr())
+				return true;
+			__atomic_store_n(&m_signalPending, false, __ATOMIC_RELEASE); //let next post try again
+			return false;
+		}
+
+	private:
+		struct WorkItem
+		{
+			WorkFunction function;
+			uint32_t context;
+		};
+
+		framework::LockFreeRing<WorkItem, Slots> m_items;
+		Event m_posted;
+		bool m_signalPending; // worker will wake up, posts do not need to signal it
+		Task<StackSize> m_worker;
+		const char *m_name;
+
+		static void workerFunction(uint32_t parameter)
+		{
+			WorkQueue &queue = *reinterpret_cast<WorkQueue *>(static_cast<uintptr_t>(parameter));
+			WorkItem item;
+			while (true)
+			{
+				queue.m_posted.wait();
+				//cleared before draining, so a work posted during the batch signals again
+				__atomic_store_n(&queue.m_signalPending, false, __ATOMIC_RELEASE);
+				while (queue.m_items.pop(item))
+					item.function(item.context);
+			}
+		}
+	};
+} // namespace kernel
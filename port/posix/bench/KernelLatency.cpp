@@ -0,0 +1,248 @@
+/*MIT License
+
+Copyright (c) 2019 Florian GERARD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Except as contained in this notice, the name of Florian GERARD shall not be used 
+in advertising or otherwise to promote the sale, use or other dealings in this 
+Software without prior written authorization from Florian GERARD
+
+*/
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <unistd.h>
+#include "core/Core.hpp"
+#include "yggdrasil/kernel/Api.hpp"
+#include "yggdrasil/kernel/Event.hpp"
+#include "yggdrasil/kernel/LatencyProbes.hpp"
+#include "yggdrasil/kernel/Mutex.hpp"
+#include "yggdrasil/kernel/Semaphore.hpp"
+#include "yggdrasil/framework/Histogram.hpp"
+
+/* Kernel latency scenarios on host port
+ * context switch: yield to a task of same priority, until it runs
+ * sleep(0): sleep call until task runs again
+ * event ping-pong: signal a task and wait for its answer
+ * mutex handoff: release a mutex a higher priority task waits for, until it owns it
+ * isr wake: interrupt giving a semaphore, until waiting task runs
+ * system tick: tick handler with N tasks sleeping one tick, kernel probe only
+ * rows marked (kernel) come from latency probes, kernel side only
+ * argument: samples per scenario (default 2000)
+ * output: CSV, nanoseconds of host time (probes: host cycles, one per nanosecond by default) */
+
+using namespace kernel;
+
+namespace
+{
+	constexpr core::interfaces::Irq benchIrq = 3;
+	constexpr uint32_t driverPriority = 2;
+	constexpr uint32_t maxSleepers = 32;
+	constexpr uint32_t tickWindow = 100; // ticks measured per sleeper count
+
+	using Clock = std::chrono::steady_clock;
+	using Histogram = framework::Histogram<4>;
+
+	Task<1024> driver;
+	Task<512> switchPartner, eventResponder, mutexWaiter, isrWaiter;
+	Task<256> sleepers[maxSleepers];
+	Event switchGo, request, answer, handoffGo;
+	Mutex mutex;
+	Semaphore isrSemaphore(0, 1000);
+
+	uint32_t samples = 2000;
+	Histogram histogram;
+	std::atomic<int64_t> stamp(0);
+	std::atomic<bool> raising(false);
+
+	int64_t now()
+	{
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+	}
+
+	void recordSince(int64_t start)
+	{
+		histogram.record(static_cast<uint32_t>(now() - start));
+	}
+
+	void printRow(const char *scenario, uint32_t count, uint32_t minimum, uint32_t mean, uint32_t median, uint32_t percentile90, uint32_t percentile99, uint32_t maximum)
+	{
+		printf("%s,%u,%u,%u,%u,%u,%u,%u\n", scenario, count, minimum, mean, median, percentile90, percentile99, maximum);
+	}
+
+	void printHistogram(const char *scenario)
+	{
+		printRow(scenario, histogram.count(), histogram.minimum(), histogram.mean(), histogram.percentile(500), histogram.percentile(900), histogram.percentile(990), histogram.maximum());
+		histogram.reset();
+	}
+
+	void printProbe(const char *scenario, LatencyProbe probe)
+	{
+		LatencyStatistics statistics;
+		if (LatencyProbes::snapshot(probe, statistics))
+			printRow(scenario, statistics.count, statistics.minimum, statistics.mean, statistics.median, statistics.percentile90, statistics.percentile99, statistics.maximum);
+	}
+
+	void switchPartnerTask(uint32_t)
+	{
+		while (true)
+		{
+			switchGo.wait();
+			for (uint32_t i = 0; i < samples; i++)
+			{
+				recordSince(stamp);
+				Api::yield();
+			}
+		}
+	}
+
+	void eventResponderTask(uint32_t)
+	{
+		while (true)
+		{
+			request.wait();
+			answer.signal();
+		}
+	}
+
+	void mutexWaiterTask(uint32_t)
+	{
+		while (true)
+		{
+			handoffGo.wait();
+			mutex.lock();
+			recordSince(stamp);
+			mutex.release();
+		}
+	}
+
+	void isrWaiterTask(uint32_t)
+	{
+		while (true)
+		{
+			isrSemaphore.take();
+			recordSince(stamp);
+		}
+	}
+
+	void irqHandler()
+	{
+		stamp = now();
+		isrSemaphore.giveFromIsr();
+	}
+
+	void sleeperTask(uint32_t)
+	{
+		while (true)
+			Api::sleep(1);
+	}
+
+	void driverTask(uint32_t)
+	{
+		printf("scenario,count,min,avg,p50,p90,p99,max\n");
+
+		LatencyProbes::reset();
+		switchGo.signal();
+		for (uint32_t i = 0; i < samples; i++)
+		{
+			stamp = now();
+			Api::yield();
+		}
+		Api::yield(); // partner records last sample
+		printHistogram("context switch");
+		printProbe("context switch (kernel)", LatencyProbe::taskSwitch);
+
+		uint32_t sleeps = (samples < 200) ? samples : 200; // a sleep lasts until next tick
+		for (uint32_t i = 0; i < sleeps; i++)
+		{
+			int64_t start = now();
+			Api::sleep(0);
+			recordSince(start);
+		}
+		printHistogram("sleep(0)");
+
+		for (uint32_t i = 0; i < samples; i++)
+		{
+			int64_t start = now();
+			request.signal();
+			answer.wait();
+			recordSince(start);
+		}
+		printHistogram("event ping-pong");
+
+		for (uint32_t i = 0; i < samples; i++)
+		{
+			mutex.lock();
+			handoffGo.signal(); // waiter preempts and blocks on mutex
+			stamp = now();
+			mutex.release();
+		}
+		printHistogram("mutex handoff");
+
+		LatencyProbes::reset();
+		raising = true;
+		std::thread([] {
+			while (raising)
+			{
+				std::this_thread::sleep_for(std::chrono::microseconds(200));
+				core::Core::raiseIrq(benchIrq);
+			}
+		}).detach();
+		while (histogram.count() < samples)
+			Api::sleep(10);
+		raising = false;
+		printHistogram("isr wake");
+		printProbe("isr wake (kernel readyToRun)", LatencyProbe::readyToRun);
+
+		static const uint32_t sleeperCounts[] = {0, 8, maxSleepers};
+		uint32_t started = 0;
+		for (uint32_t count : sleeperCounts)
+		{
+			for (; started < count; started++)
+				sleepers[started].start(sleeperTask, true, 1);
+			Api::sleep(2); // every sleeper is in timer wheel
+			LatencyProbes::reset();
+			Api::sleep(tickWindow);
+			char scenario[48];
+			snprintf(scenario, sizeof(scenario), "system tick %u sleepers (kernel)", count);
+			printProbe(scenario, LatencyProbe::systemTick);
+		}
+		fflush(stdout);
+		_exit(0);
+	}
+} // namespace
+
+int main(int argc, char **argv)
+{
+	if (argc > 1)
+		samples = static_cast<uint32_t>(strtoul(argv[1], nullptr, 0));
+	Api::setupKernel(1);
+	driver.start(driverTask, true, driverPriority);
+	switchPartner.start(switchPartnerTask, true, driverPriority);
+	eventResponder.start(eventResponderTask, true, driverPriority);
+	mutexWaiter.start(mutexWaiterTask, true, driverPriority + 1);
+	isrWaiter.start(isrWaiterTask, true, 6);
+	Api::setupInterrupt(benchIrq, irqHandler, 4);
+	Api::enableIrq(benchIrq);
+	Api::startKernel();
+	return 1;
+}
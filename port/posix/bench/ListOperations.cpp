@@ -0,0 +1,131 @@
+/*MIT License
+
+Copyright (c) 2019 Florian GERARD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Except as contained in this notice, the name of Florian GERARD shall not be used 
+in advertising or otherwise to promote the sale, use or other dealings in this 
+Software without prior written authorization from Florian GERARD
+
+*/
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include "yggdrasil/framework/DualLinkedList.hpp"
+
+/* DualLinkedList operation costs against list length
+ * insertEnd, isLinked and remove must not depend on length, walk is the search removal and contain do, for reference
+ * argument: operations per measurement (default 1000000)
+ * output: CSV, nanoseconds per operation */
+
+namespace
+{
+	class Node;
+	class NodeList : public framework::DualLinkedList<Node, NodeList>
+	{
+	};
+	class Node : public framework::DualLinkNode<Node, NodeList>
+	{
+	};
+	using Link = framework::DualLinkNode<Node, NodeList>;
+
+	using Clock = std::chrono::steady_clock;
+
+	double nanosecondsPerOperation(Clock::time_point start, uint64_t operations)
+	{
+		return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / static_cast<double>(operations);
+	}
+
+	// removal order, same for every length so that measures compare
+	std::vector<uint32_t> shuffled(uint32_t length)
+	{
+		std::vector<uint32_t> order(length);
+		uint32_t state = 2463534242u;
+		for (uint32_t i = 0; i < length; i++)
+			order[i] = i;
+		for (uint32_t i = length - 1; i > 0; i--)
+		{
+			state ^= state << 13;
+			state ^= state >> 17;
+			state ^= state << 5;
+			std::swap(order[i], order[state % (i + 1)]);
+		}
+		return order;
+	}
+
+	// find a node by walking from head
+	bool walk(NodeList &list, Node *node)
+	{
+		for (Node *current = list.peekFirst(); current != nullptr; current = Link::next(current))
+		{
+			if (current == node)
+				return true;
+		}
+		return false;
+	}
+} // namespace
+
+int main(int argc, char **argv)
+{
+	uint64_t operations = (argc > 1) ? strtoull(argv[1], nullptr, 0) : 1000000;
+	static const uint32_t lengths[] = {16, 64, 256, 1024, 4096};
+	volatile bool sink = false;
+
+	printf("length,insertEnd,isLinked,remove,walk\n");
+	for (uint32_t length : lengths)
+	{
+		std::vector<Node> nodes(length);
+		std::vector<uint32_t> order = shuffled(length);
+		uint64_t rounds = (operations + length - 1) / length;
+		NodeList list;
+
+		double insertTime = 0;
+		double removeTime = 0;
+		for (uint64_t round = 0; round < rounds; round++)
+		{
+			Clock::time_point start = Clock::now();
+			for (uint32_t i = 0; i < length; i++)
+				list.insertEnd(&nodes[i]);
+			insertTime += nanosecondsPerOperation(start, length);
+			start = Clock::now();
+			for (uint32_t i = 0; i < length; i++)
+				list.remove(&nodes[order[i]]);
+			removeTime += nanosecondsPerOperation(start, length);
+		}
+
+		for (uint32_t i = 0; i < length; i++)
+			list.insertEnd(&nodes[i]);
+		Clock::time_point start = Clock::now();
+		for (uint64_t i = 0; i < operations; i++)
+			sink = Link::isLinked(&nodes[order[i % length]]);
+		double linkedTime = nanosecondsPerOperation(start, operations);
+
+		uint64_t walks = (operations / length) + 1; // a walk costs length steps
+		start = Clock::now();
+		for (uint64_t i = 0; i < walks; i++)
+			sink = walk(list, &nodes[order[i % length]]);
+		double walkTime = nanosecondsPerOperation(start, walks);
+
+		printf("%u,%.2f,%.2f,%.2f,%.2f\n", length, insertTime / rounds, linkedTime, removeTime / rounds, walkTime);
+	}
+	(void)sink;
+	return 0;
+}
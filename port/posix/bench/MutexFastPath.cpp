@@ -0,0 +1,104 @@
+/*MIT License
+
+Copyright (c) 2019 Florian GERARD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Except as contained in this notice, the name of Florian GERARD shall not be used 
+in advertising or otherwise to promote the sale, use or other dealings in this 
+Software without prior written authorization from Florian GERARD
+
+*/
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <unistd.h>
+#include "core/Core.hpp"
+#include "yggdrasil/kernel/Api.hpp"
+#include "yggdrasil/kernel/Mutex.hpp"
+#include "yggdrasil/framework/Histogram.hpp"
+
+/* Uncontended lock and release costs, from a single task
+ * mutex: compare and swap fast path, no service call
+ * ceiling at base: ceiling not above owner priority, thread mode only
+ * ceiling raising: lock raises in thread mode, release lowers through one service call
+ * service call: Api::yield with no other ready task, a bare kernel round trip for reference
+ * argument: samples per scenario (default 10000), a sample times a batch of pairs
+ * output: CSV, nanoseconds per lock and release pair (host time, not target cycles) */
+
+using namespace kernel;
+
+namespace
+{
+	constexpr uint32_t batch = 64;
+	constexpr uint32_t basePriority = 2;
+
+	using Clock = std::chrono::steady_clock;
+	using Histogram = framework::Histogram<4>;
+
+	Task<1024> bench;
+	Mutex mutex;
+	CeilingMutex ceilingAtBase(basePriority), ceilingRaising(basePriority + 3);
+	uint32_t samples = 10000;
+
+	template<typename Operation>
+	void measure(const char *name, Operation operation)
+	{
+		Histogram histogram;
+		for (uint32_t sample = 0; sample < samples; sample++)
+		{
+			Clock::time_point start = Clock::now();
+			for (uint32_t i = 0; i < batch; i++)
+				operation();
+			double elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+			histogram.record(static_cast<uint32_t>(elapsed / batch));
+		}
+		printf("%s,%u,%u,%u,%u,%u\n", name, histogram.minimum(), histogram.mean(), histogram.percentile(500), histogram.percentile(990), histogram.maximum());
+	}
+
+	void benchTask(uint32_t)
+	{
+		printf("scenario,min,avg,p50,p99,max\n");
+		measure("mutex", [] {
+			mutex.lock();
+			mutex.release();
+		});
+		measure("ceiling at base", [] {
+			ceilingAtBase.lock();
+			ceilingAtBase.release();
+		});
+		measure("ceiling raising", [] {
+			ceilingRaising.lock();
+			ceilingRaising.release();
+		});
+		measure("service call", [] { Api::yield(); });
+		fflush(stdout);
+		_exit(0);
+	}
+} // namespace
+
+int main(int argc, char **argv)
+{
+	if (argc > 1)
+		samples = static_cast<uint32_t>(strtoul(argv[1], nullptr, 0));
+	Api::setupKernel(1);
+	bench.start(benchTask, true, basePriority);
+	Api::startKernel();
+	return 1;
+}
@@ -0,0 +1,115 @@
+/*MIT License
+
+Copyright (c) 2019 Florian GERARD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Except as contained in this notice, the name of Florian GERARD shall not be used 
+in advertising or otherwise to promote the sale, use or other dealings in this 
+Software without prior written authorization from Florian GERARD
+
+*/
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <unistd.h>
+#include "core/Core.hpp"
+#include "yggdrasil/kernel/Api.hpp"
+#include "yggdrasil/kernel/Event.hpp"
+#include "yggdrasil/kernel/Notification.hpp"
+#include "yggdrasil/framework/Histogram.hpp"
+
+/* Round trip between two tasks: direct notifications against a pair of events
+ * initiator wakes responder and waits for its answer, both run at the same priority
+ * argument: round trips per scenario (default 10000)
+ * output: CSV, nanoseconds per round trip (host time, not target cycles) */
+
+using namespace kernel;
+
+namespace
+{
+	constexpr uint32_t priority = 2;
+
+	using Clock = std::chrono::steady_clock;
+	using Histogram = framework::Histogram<4>;
+
+	Task<1024> initiator, notified, eventResponder;
+	Event request, answer;
+	uint32_t samples = 10000;
+
+	void notifiedTask(uint32_t)
+	{
+		uint32_t value;
+		while (true)
+		{
+			Api::waitNotification(value);
+			initiator.notify(value, NotifyAction::overwrite);
+		}
+	}
+
+	void eventResponderTask(uint32_t)
+	{
+		while (true)
+		{
+			request.wait();
+			answer.signal();
+		}
+	}
+
+	template<typename RoundTrip>
+	void measure(const char *name, RoundTrip roundTrip)
+	{
+		Histogram histogram;
+		for (uint32_t sample = 0; sample < samples; sample++)
+		{
+			Clock::time_point start = Clock::now();
+			roundTrip(sample);
+			histogram.record(static_cast<uint32_t>(std::chrono::duration<double, std::nano>(Clock::now() - start).count()));
+		}
+		printf("%s,%u,%u,%u,%u,%u\n", name, histogram.minimum(), histogram.mean(), histogram.percentile(500), histogram.percentile(990), histogram.maximum());
+	}
+
+	void initiatorTask(uint32_t)
+	{
+		printf("scenario,min,avg,p50,p99,max\n");
+		measure("notification", [](uint32_t sample) {
+			uint32_t value;
+			notified.notify(sample, NotifyAction::overwrite);
+			Api::waitNotification(value);
+		});
+		measure("event", [](uint32_t) {
+			request.signal();
+			answer.wait();
+		});
+		fflush(stdout);
+		_exit(0);
+	}
+} // namespace
+
+int main(int argc, char **argv)
+{
+	if (argc > 1)
+		samples = static_cast<uint32_t>(strtoul(argv[1], nullptr, 0));
+	Api::setupKernel(1);
+	initiator.start(initiatorTask, true, priority);
+	notified.start(notifiedTask, true, priority);
+	eventResponder.start(eventResponderTask, true, priority);
+	Api::startKernel();
+	return 1;
+}
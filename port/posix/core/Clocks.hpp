@@ -0,0 +1,57 @@
+/*MIT License
+
+Copyright (c) 2019 Florian GERARD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Except as contained in this notice, the name of Florian GERARD shall not be used 
+in advertising or otherwise to promote the sale, use or other dealings in this 
+Software without prior written authorization from Florian GERARD
+
+*/
+#pragma once
+#include <cstdint>
+#include "yggdrasil/interfaces/IClocks.hpp"
+
+#ifndef HOST_CORE_FREQUENCY
+#define HOST_CORE_FREQUENCY 1000000000 // one cycle per nanosecond
+#endif
+
+namespace core
+{
+	// nominal frequency, cycles are derived from host monotonic clock
+	class Clocks : public interfaces::IClocks
+	{
+	public:
+		uint32_t getSystemCoreFrequency() override
+		{
+			return HOST_CORE_FREQUENCY;
+		}
+
+		bool init() override
+		{
+			return true;
+		}
+
+		uint32_t getClockFrequency(uint32_t) override
+		{
+			return HOST_CORE_FREQUENCY;
+		}
+	};
+} // namespace core
@@ -0,0 +1,214 @@
+/*MIT License
+
+Copyright (c) 2019 Florian GERARD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Except as contained in this notice, the name of Florian GERARD shall not be used 
+in advertising or otherwise to promote the sale, use or other dealings in this 
+Software without prior written authorization from Florian GERARD
+
+*/
+#include "Core.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <sys/mman.h>
+#include "yggdrasil/kernel/Scheduler.hpp"
+
+namespace core
+{
+	VectorManager Core::s_vectorManager;
+	Clocks Core::s_clocks;
+
+#ifdef HOST_SIMULATION
+	interfaces::ISystemTimer &Core::systemTimer = Simulation::s_timer;
+#else
+	SystemTimer Core::s_systemTimer(Core::s_vectorManager);
+	interfaces::ISystemTimer &Core::systemTimer = Core::s_systemTimer;
+#endif
+	interfaces::IClocks &Core::coreClocks = Core::s_clocks;
+	interfaces::IVectorManager &Core::vectorManager = Core::s_vectorManager;
+
+	kernel::Task<256> Core::idleTask;
+
+	Core::Context Core::s_contexts[HOST_MAX_TASKS] = {};
+	uint32_t Core::s_mainFrame[18] = {};
+	uint32_t volatile *Core::s_currentFrame = Core::s_mainFrame;
+	kernel::ServiceCall::SvcNumber Core::s_serviceNumber;
+
+	void Core::idleFunc(uint32_t)
+	{
+		while (true)
+			waitForInterrupt();
+	}
+
+	void Core::systemTimerHandler()
+	{
+#ifdef HOST_SIMULATION
+		Simulation::onTick();
+#else
+		s_systemTimer.acknowledge();
+#endif
+		kernel::Scheduler::systemTimerTick();
+	}
+
+	void Core::supervisorCallHandler()
+	{
+#ifdef HOST_SIMULATION
+		Simulation::onServiceCall();
+#endif
+		kernel::Scheduler::supervisorCall(s_serviceNumber, const_cast<uint32_t *>(s_currentFrame + 10));
+	}
+
+	/* PendSV, runs with interrupt signal blocked so that no handler sees a half switched context
+	 * outgoing task is suspended here and resumes here once elected again */
+	void Core::contextSwitchHandler()
+	{
+		sigset_t previous;
+		VectorManager::blockInterruptSignal(&previous);
+		uint32_t volatile *next = kernel::Scheduler::taskSwitch(const_cast<uint32_t *>(s_currentFrame));
+		if (next != s_currentFrame)
+		{
+#ifdef HOST_SIMULATION
+			Simulation::onContextSwitch();
+#endif
+			Context &from = contextOf(s_currentFrame);
+			Context &to = contextOf(next);
+			s_currentFrame = next;
+			swapcontext(&from.context, &to.context);
+		}
+		VectorManager::restoreInterruptSignal(&previous);
+	}
+
+	void Core::restoreTask(uint32_t volatile *stackPointer)
+	{
+		Context &to = contextOf(stackPointer);
+		s_currentFrame = stackPointer;
+		setcontext(&to.context);
+	}
+
+	void Core::contextSwitchTrigger()
+	{
+		s_vectorManager.raise(taskSwitchIrqNumber);
+	}
+
+	uint32_t Core::getCurrentInterruptNumber()
+	{
+		return s_vectorManager.activeVector();
+	}
+
+	void Core::waitForInterrupt()
+	{
+#ifdef HOST_SIMULATION
+		Simulation::s_timer.idle();
+#else
+		sigset_t previous;
+		VectorManager::blockInterruptSignal(&previous);
+		sigset_t waiting = previous;
+		sigdelset(&waiting, HOST_INTERRUPT_SIGNAL);
+		while (!s_vectorManager.isAnyPending())
+			sigsuspend(&waiting);
+		VectorManager::restoreInterruptSignal(&previous);
+#endif
+	}
+
+	void Core::raiseIrq(interfaces::Irq irq)
+	{
+		s_vectorManager.raise(irq);
+	}
+
+	// svc is taken at once from thread mode, it is a fault from a handler or with kernel priority masked
+	void Core::serviceCall(kernel::ServiceCall::SvcNumber number)
+	{
+		if (s_vectorManager.activeVector() != 0)
+		{
+			fprintf(stderr, "yggdrasil: service call %u from interrupt handler\n", static_cast<uint32_t>(number));
+			abort();
+		}
+		sigset_t previous;
+		VectorManager::blockInterruptSignal(&previous);
+		s_serviceNumber = number;
+		s_vectorManager.raise(supervisorIrqNumber);
+		if (s_vectorManager.isPending(supervisorIrqNumber))
+		{
+			fprintf(stderr, "yggdrasil: service call %u with interrupts masked\n", static_cast<uint32_t>(number));
+			abort();
+		}
+		VectorManager::restoreInterruptSignal(&previous);
+	}
+
+	/* Host context of the task owning frame
+	 * a frame still holding EXC_RETURN was just built by TaskController::start, it gets a fresh context,
+	 * host stack of a stopped task is reused when it starts again */
+	Core::Context &Core::contextOf(uint32_t volatile *frame)
+	{
+		Context *context = nullptr;
+		for (Context &candidate : s_contexts)
+		{
+			if (candidate.frame == frame)
+			{
+				context = &candidate;
+				break;
+			}
+			if (context == nullptr && candidate.frame == nullptr)
+				context = &candidate;
+		}
+		if (context == nullptr)
+		{
+			fprintf(stderr, "yggdrasil: more than %d tasks, raise HOST_MAX_TASKS\n", HOST_MAX_TASKS);
+			abort();
+		}
+		if (context->frame == frame && frame[0] != 0xFFFFFFFD)
+			return *context;
+		if (context->stack == nullptr)
+		{
+			int flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_STACK;
+#if defined(MAP_32BIT) && UINTPTR_MAX > 0xFFFFFFFFu
+			flags |= MAP_32BIT; // task locals are passed to kernel in 32 bits words
+#endif
+			context->stack = mmap(nullptr, HOST_TASK_STACK_SIZE, PROT_READ | PROT_WRITE, flags, -1, 0);
+			if (context->stack == MAP_FAILED)
+			{
+				perror("yggdrasil: task stack");
+				abort();
+			}
+		}
+		context->frame = frame;
+		getcontext(&context->context);
+		context->context.uc_stack.ss_sp = context->stack;
+		context->context.uc_stack.ss_size = HOST_TASK_STACK_SIZE;
+		context->context.uc_link = nullptr;
+		sigaddset(&context->context.uc_sigmask, HOST_INTERRUPT_SIGNAL);
+		makecontext(&context->context, taskEntry, 0);
+		frame[0] = 0; // running on host context from now on
+		return *context;
+	}
+
+	// exception return to a new task: r0 to r2 are arguments of pc, lr is called if pc returns
+	void Core::taskEntry()
+	{
+		uint32_t volatile *frame = s_currentFrame;
+		auto entry = reinterpret_cast<void (*)(uintptr_t, uintptr_t, uintptr_t)>(static_cast<uintptr_t>(frame[16]));
+		auto exit = reinterpret_cast<void (*)()>(static_cast<uintptr_t>(frame[15]));
+		uintptr_t r0 = frame[10], r1 = frame[11], r2 = frame[12];
+		s_vectorManager.exceptionReturn();
+		entry(r0, r1, r2);
+		exit();
+	}
+} // namespace core
@@ -0,0 +1,161 @@
+/*MIT License
+
+Copyright (c) 2019 Florian GERARD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Except as contained in this notice, the name of Florian GERARD shall not be used 
+in advertising or otherwise to promote the sale, use or other dealings in this 
+Software without prior written authorization from Florian GERARD
+
+*/
+#pragma once
+#include <cstdint>
+#include <type_traits>
+#include <ucontext.h>
+#include "yggdrasil/kernel/ServiceCall.hpp"
+#include "yggdrasil/kernel/Task.hpp"
+#include "yggdrasil/interfaces/IVectorsManager.hpp"
+#include "yggdrasil/interfaces/ISystemTimer.hpp"
+#include "yggdrasil/interfaces/IClocks.hpp"
+#include "VectorManager.hpp"
+#include "Clocks.hpp"
+#ifdef HOST_SIMULATION
+#include "Simulation.hpp"
+#else
+#include "SystemTimer.hpp"
+#endif
+
+/* Host port, kernel runs as a Linux process
+ * Whole kernel runs in one host thread, interrupts are simulated by VectorManager,
+ * each task runs on its own host stack switched with ucontext.
+ * With HOST_SIMULATION, system timer runs on virtual time instead, see Simulation.
+ * Kernel stores pointers in 32 bits words, build it for an ILP32 target (-m32),
+ * or on LP64 as a non PIE executable so that image and task stacks stay in the low 4 GiB (see CMakeLists.txt) */
+
+#ifndef HOST_MAX_TASKS
+#define HOST_MAX_TASKS 64
+#endif
+
+#ifndef HOST_TASK_STACK_SIZE
+#define HOST_TASK_STACK_SIZE (256 * 1024)
+#endif
+
+#define __BKPT(value) __builtin_trap()
+#define __WFI() core::Core::waitForInterrupt()
+#define __DSB() __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#define __ISB() __atomic_signal_fence(__ATOMIC_SEQ_CST)
+
+namespace core
+{
+	class Core
+	{
+		friend class Simulation;
+
+	public:
+		/* Service call, same contract as svc instruction
+		 * arguments are copied to the frame of the calling task where kernel finds them (stacked r0 to r3),
+		 * kernel writes result in stacked r0, possibly while calling task is blocked */
+		template <kernel::ServiceCall::SvcNumber Number, typename R, typename... Args>
+		static R supervisorCall(Args... args)
+		{
+			static_assert(sizeof...(Args) <= 4, "service call arguments are passed in r0 to r3");
+			uint32_t volatile *frame = s_currentFrame;
+			uint32_t index = 10;
+			(storeArgument(frame, index++, toWord(args)), ...);
+			serviceCall(Number);
+			if constexpr (!std::is_void_v<R>)
+				return fromWord<R>(frame[10]);
+		}
+
+		static kernel::Task<256> idleTask;
+		static void idleFunc(uint32_t);
+
+		static interfaces::ISystemTimer &systemTimer;
+		static interfaces::IClocks &coreClocks;
+		static interfaces::IVectorManager &vectorManager;
+
+		static void systemTimerHandler();
+		static void supervisorCallHandler();
+		static void contextSwitchHandler();
+
+		static constexpr interfaces::Irq supervisorIrqNumber = -5;
+		static constexpr interfaces::Irq taskSwitchIrqNumber = -2;
+
+		static void restoreTask(uint32_t volatile *stackPointer);
+		static void contextSwitchTrigger();
+		static uint32_t getCurrentInterruptNumber();
+
+		// sleep until an interrupt is pending, even if masked, like wfi
+		static void waitForInterrupt();
+
+		// set an interrupt pending, can be called from any host thread or signal handler
+		static void raiseIrq(interfaces::Irq irq);
+
+	private:
+		struct Context
+		{
+			uint32_t volatile *frame;
+			ucontext_t context;
+			void *stack;
+		};
+
+		static VectorManager s_vectorManager;
+#ifndef HOST_SIMULATION
+		static SystemTimer s_systemTimer;
+#endif
+		static Clocks s_clocks;
+
+		static Context s_contexts[HOST_MAX_TASKS];
+		static uint32_t s_mainFrame[18];					// frame used by service calls made before kernel start
+		static uint32_t volatile *s_currentFrame;			// frame of running task
+		static kernel::ServiceCall::SvcNumber s_serviceNumber;
+
+		static void serviceCall(kernel::ServiceCall::SvcNumber number);
+		static Context &contextOf(uint32_t volatile *frame);
+		static void taskEntry();
+
+		static void storeArgument(uint32_t volatile *frame, uint32_t index, uint32_t word)
+		{
+			frame[index] = word;
+		}
+
+		template <typename T>
+		static uint32_t toWord(T value)
+		{
+			if constexpr (std::is_pointer_v<T>)
+				return static_cast<uint32_t>(reinterpret_cast<uintptr_t>(value));
+			else if constexpr (std::is_class_v<T>) // Irq
+				return static_cast<uint32_t>(static_cast<int16_t>(value));
+			else
+				return static_cast<uint32_t>(value);
+		}
+
+		template <typename R>
+		static R fromWord(uint32_t word)
+		{
+			if constexpr (std::is_same_v<R, bool>)
+				return word != 0;
+			else if constexpr (std::is_pointer_v<R>)
+				return reinterpret_cast<R>(static_cast<uintptr_t>(word));
+			else
+				return static_cast<R>(word);
+		}
+	};
+} // namespace core
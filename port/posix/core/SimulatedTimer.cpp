@@ -0,0 +1,199 @@
+/*MIT License
+
+Copyright (c) 2019 Florian GERARD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Except as contained in this notice, the name of Florian GERARD shall not be used 
+in advertising or otherwise to promote the sale, use or other dealings in this 
+Software without prior written authorization from Florian GERARD
+
+*/
+#include "SimulatedTimer.hpp"
+
+#ifdef HOST_SIMULATION
+namespace core
+{
+	SimulatedTimer::SimulatedTimer(VectorManager &vectorManager, StopHandler onStop)
+		: m_vectorManager(vectorManager), m_onStop(onStop), m_injections(), m_now(0), m_cyclesPerTick(1), m_origin(0), m_periodStart(0), m_nextTick(never), m_oneShotStart(0),
+		  m_stopTime(never), m_idleCycles(0), m_sequence(0), m_raised(0), m_running(false), m_oneShot(false)
+	{
+	}
+
+	void SimulatedTimer::initSystemTimer(uint32_t coreFrequency, uint32_t ticksFrequency)
+	{
+		m_cyclesPerTick = coreFrequency / ticksFrequency;
+	}
+
+	void SimulatedTimer::startSystemTimer()
+	{
+		m_origin = m_now;
+		m_periodStart = m_now;
+		m_nextTick = m_now + m_cyclesPerTick;
+		m_running = true;
+	}
+
+	Irq SimulatedTimer::getIrq()
+	{
+		return -1; // SysTick
+	}
+
+	uint32_t SimulatedTimer::maxOneShotTicks()
+	{
+		return 0x7FFFFFFF;
+	}
+
+	void SimulatedTimer::startOneShot(uint32_t ticks)
+	{
+		m_oneShotStart = m_periodStart;
+		m_nextTick = m_oneShotStart + ticks * m_cyclesPerTick;
+		m_raised = 0;
+		m_oneShot = true;
+	}
+
+	uint32_t SimulatedTimer::stopOneShot()
+	{
+		uint64_t boundary = m_origin + ((m_now - m_origin) / m_cyclesPerTick) * m_cyclesPerTick;
+		if (boundary < m_oneShotStart)
+			boundary = m_oneShotStart;
+		m_periodStart = boundary;
+		m_nextTick = boundary + m_cyclesPerTick;
+		m_oneShot = false;
+		return static_cast<uint32_t>((boundary - m_oneShotStart) / m_cyclesPerTick) - m_raised;
+	}
+
+	uint32_t SimulatedTimer::cyclesSinceTick()
+	{
+		return m_running ? static_cast<uint32_t>(m_now - m_periodStart) : 0;
+	}
+
+	bool SimulatedTimer::isTickPending()
+	{
+		return m_vectorManager.isPending(getIrq());
+	}
+
+	uint64_t SimulatedTimer::now() const
+	{
+		return m_now;
+	}
+
+	uint64_t SimulatedTimer::idleCycles() const
+	{
+		return m_idleCycles;
+	}
+
+	uint64_t SimulatedTimer::tickTime(uint64_t ticks) const
+	{
+		return m_origin + ticks * m_cyclesPerTick;
+	}
+
+	void SimulatedTimer::advance(uint64_t cycles)
+	{
+		uint64_t remaining = cycles; // local, task keeps what is left if an interrupt switches to another one
+		while (remaining != 0)
+		{
+			uint64_t next = nextEvent();
+			uint64_t step = (next > m_now) ? next - m_now : 0;
+			if (step > remaining)
+				step = remaining;
+			m_now += step;
+			remaining -= step;
+			fireDue();
+		}
+	}
+
+	void SimulatedTimer::idle()
+	{
+		while (!m_vectorManager.isAnyPending())
+		{
+			uint64_t next = nextEvent();
+			if (next == never) // nothing can wake the core any more
+				m_onStop();
+			if (next > m_now)
+			{
+				m_idleCycles += next - m_now;
+				m_now = next;
+			}
+			fireDue();
+		}
+	}
+
+	void SimulatedTimer::charge(uint64_t cycles)
+	{
+		m_now += cycles;
+	}
+
+	void SimulatedTimer::inject(uint64_t time, Irq irq, uint64_t period, uint32_t count)
+	{
+		m_injections.push({time, m_sequence++, period, count, static_cast<int16_t>(irq)});
+	}
+
+	void SimulatedTimer::stopAt(uint64_t time)
+	{
+		m_stopTime = time;
+	}
+
+	uint64_t SimulatedTimer::nextEvent()
+	{
+		uint64_t next = m_stopTime;
+		if (m_running && m_nextTick < next)
+			next = m_nextTick;
+		if (!m_injections.empty() && m_injections.top().time < next)
+			next = m_injections.top().time;
+		return next;
+	}
+
+	// state is updated before each raise, a raise may switch to another task which fires next events itself
+	void SimulatedTimer::fireDue()
+	{
+		if (m_now >= m_stopTime)
+			m_onStop();
+		if (m_running && m_nextTick <= m_now)
+		{
+			if (m_oneShot)
+			{
+				m_periodStart = m_nextTick;
+				m_nextTick = never; // until stopOneShot goes back to periodic
+			}
+			else // periods skipped by a long charge are lost, as with a late SysTick
+			{
+				m_periodStart = m_nextTick + ((m_now - m_nextTick) / m_cyclesPerTick) * m_cyclesPerTick;
+				m_nextTick = m_periodStart + m_cyclesPerTick;
+			}
+			m_raised++;
+			m_vectorManager.raise(getIrq());
+		}
+		while (!m_injections.empty() && m_injections.top().time <= m_now)
+		{
+			Injection injection = m_injections.top();
+			m_injections.pop();
+			if (injection.period != 0 && injection.count != 1)
+			{
+				Injection next = injection;
+				next.time += injection.period;
+				next.sequence = m_sequence++;
+				if (next.count != 0)
+					next.count--;
+				m_injections.push(next);
+			}
+			m_vectorManager.raise(injection.irq);
+		}
+	}
+} // namespace core
+#endif // HOST_SIMULATION
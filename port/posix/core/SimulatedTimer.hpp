@@ -0,0 +1,114 @@
+/*MIT License
+
+Copyright (c) 2019 Florian GERARD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Except as contained in this notice, the name of Florian GERARD shall not be used 
+in advertising or otherwise to promote the sale, use or other dealings in this 
+Software without prior written authorization from Florian GERARD
+
+*/
+#pragma once
+#include <cstdint>
+#include <queue>
+#include <vector>
+#include "yggdrasil/interfaces/ISystemTimer.hpp"
+#include "VectorManager.hpp"
+
+namespace core
+{
+	/* System timer on a virtual clock, counted in core cycles
+	 * Clock only moves when a task reports execution time (advance) or when the core waits for interrupt (idle),
+	 * then it goes straight to the next event: tick, one shot end or injected interrupt.
+	 * Everything runs in kernel thread, a run is fully deterministic */
+	class SimulatedTimer : public interfaces::ISystemTimer
+	{
+	public:
+		static constexpr uint64_t never = UINT64_MAX;
+
+		using StopHandler = void (*)();
+
+		SimulatedTimer(VectorManager &vectorManager, StopHandler onStop);
+
+		void initSystemTimer(uint32_t coreFrequency, uint32_t ticksFrequency) override;
+		void startSystemTimer() override;
+		Irq getIrq() override;
+
+		uint32_t maxOneShotTicks() override;
+		void startOneShot(uint32_t ticks) override;
+		uint32_t stopOneShot() override;
+
+		uint32_t cyclesSinceTick() override;
+		bool isTickPending() override;
+
+		uint64_t now() const;
+		uint64_t idleCycles() const;
+		//@return time of kernel tick number ticks, counted from first period
+		uint64_t tickTime(uint64_t ticks) const;
+
+		// task runs for cycles, interrupts due meanwhile preempt it
+		void advance(uint64_t cycles);
+		// wait for interrupt, jump to next event until one is pending
+		void idle();
+		// time spent in kernel, interrupts due meanwhile are taken at next advance or idle
+		void charge(uint64_t cycles);
+
+		// raise irq at time, then every period (if not 0) count times (0 for ever)
+		void inject(uint64_t time, Irq irq, uint64_t period, uint32_t count);
+		void stopAt(uint64_t time);
+
+	private:
+		struct Injection
+		{
+			uint64_t time;
+			uint64_t sequence; // injections due at same time are raised in injection order
+			uint64_t period;
+			uint32_t count;
+			int16_t irq;
+		};
+
+		struct Later
+		{
+			bool operator()(const Injection &first, const Injection &second) const
+			{
+				return (first.time != second.time) ? first.time > second.time : first.sequence > second.sequence;
+			}
+		};
+
+		VectorManager &m_vectorManager;
+		StopHandler m_onStop;
+		std::priority_queue<Injection, std::vector<Injection>, Later> m_injections;
+		uint64_t m_now;
+		uint64_t m_cyclesPerTick;
+		uint64_t m_origin;		 // start of first tick period
+		uint64_t m_periodStart;	 // last period end raised or reported, cycles since tick count from here
+		uint64_t m_nextTick;	 // end of current period, or one shot end
+		uint64_t m_oneShotStart;
+		uint64_t m_stopTime;
+		uint64_t m_idleCycles;
+		uint64_t m_sequence;
+		uint32_t m_raised; // tick interrupts raised since one shot start
+		bool m_running;
+		bool m_oneShot;
+
+		uint64_t nextEvent();
+		void fireDue();
+	};
+} // namespace core
@@ -0,0 +1,190 @@
+/*MIT License
+
+Copyright (c) 2019 Florian GERARD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Except as contained in this notice, the name of Florian GERARD shall not be used 
+in advertising or otherwise to promote the sale, use or other dealings in this 
+Software without prior written authorization from Florian GERARD
+
+*/
+#include "Simulation.hpp"
+
+#ifdef HOST_SIMULATION
+#include <cstdlib>
+#include "Core.hpp"
+#include "yggdrasil/kernel/Config.hpp"
+
+namespace core
+{
+	SimulatedTimer Simulation::s_timer(Core::s_vectorManager, Simulation::finish);
+	Simulation::Job *Simulation::s_jobs = nullptr;
+	uint32_t Simulation::s_serviceCallCost = HOST_SIM_SVC_CYCLES;
+	uint32_t Simulation::s_contextSwitchCost = HOST_SIM_SWITCH_CYCLES;
+	uint32_t Simulation::s_tickCost = HOST_SIM_TICK_CYCLES;
+	uint64_t Simulation::s_serviceCalls = 0;
+	uint64_t Simulation::s_contextSwitches = 0;
+	uint64_t Simulation::s_ticks = 0;
+	uint64_t Simulation::s_kernelCycles = 0;
+
+	Simulation::Job::Job(const char *name, uint64_t deadline)
+		: m_name(name), m_deadline(deadline), m_release(0), m_count(0), m_misses(0), m_minimum(UINT64_MAX), m_maximum(0), m_total(0), m_next(s_jobs)
+	{
+		s_jobs = this;
+	}
+
+	void Simulation::Job::release()
+	{
+		m_release = s_timer.now();
+	}
+
+	void Simulation::Job::release(uint64_t time)
+	{
+		m_release = time;
+	}
+
+	void Simulation::Job::complete()
+	{
+		uint64_t response = s_timer.now() - m_release;
+		m_count++;
+		m_total += response;
+		if (response < m_minimum)
+			m_minimum = response;
+		if (response > m_maximum)
+			m_maximum = response;
+		if (m_deadline != 0 && response > m_deadline)
+			m_misses++;
+	}
+
+	uint64_t Simulation::now()
+	{
+		return s_timer.now();
+	}
+
+	uint64_t Simulation::tickTime(uint64_t tick)
+	{
+		return s_timer.tickTime(tick - kernel::config::initialTicks);
+	}
+
+	uint64_t Simulation::microseconds(uint64_t us)
+	{
+		return us * HOST_CORE_FREQUENCY / 1000000;
+	}
+
+	void Simulation::consume(uint64_t cycles)
+	{
+		s_timer.advance(cycles);
+	}
+
+	void Simulation::injectIrq(uint64_t time, Irq irq, uint64_t period, uint32_t count)
+	{
+		s_timer.inject(time, irq, period, count);
+	}
+
+	bool Simulation::loadScript(const char *path)
+	{
+		FILE *script = fopen(path, "r");
+		if (script == nullptr)
+			return false;
+		char line[256];
+		bool isValid = true;
+		while (isValid && fgets(line, sizeof(line), script) != nullptr)
+		{
+			unsigned long long time, period = 0;
+			int irq;
+			unsigned count = 1;
+			char first;
+			if (sscanf(line, " %c", &first) != 1 || first == '#') // blank or comment
+				continue;
+			int fields = sscanf(line, "%llu %d %llu %u", &time, &irq, &period, &count);
+			if (fields < 2)
+				isValid = false;
+			else
+				s_timer.inject(microseconds(time), static_cast<int16_t>(irq), microseconds(period), (fields == 3) ? 0 : count);
+		}
+		fclose(script);
+		return isValid;
+	}
+
+	void Simulation::stopAt(uint64_t time)
+	{
+		s_timer.stopAt(time);
+	}
+
+	void Simulation::kernelCosts(uint32_t serviceCall, uint32_t contextSwitch, uint32_t tick)
+	{
+		s_serviceCallCost = serviceCall;
+		s_contextSwitchCost = contextSwitch;
+		s_tickCost = tick;
+	}
+
+	void Simulation::report(FILE *output)
+	{
+		uint64_t elapsed = s_timer.now();
+		auto percent = [elapsed](uint64_t part) { return (elapsed != 0) ? 100.0 * static_cast<double>(part) / static_cast<double>(elapsed) : 0.0; };
+		fprintf(output, "simulated %llu cycles, %.3f s at %u Hz\n", static_cast<unsigned long long>(elapsed),
+				static_cast<double>(elapsed) / HOST_CORE_FREQUENCY, static_cast<uint32_t>(HOST_CORE_FREQUENCY));
+		fprintf(output, "idle %llu cycles, %.2f %%\n", static_cast<unsigned long long>(s_timer.idleCycles()), percent(s_timer.idleCycles()));
+		fprintf(output, "kernel %llu cycles, %.2f %%: %llu service calls, %llu context switches, %llu ticks\n", static_cast<unsigned long long>(s_kernelCycles),
+				percent(s_kernelCycles), static_cast<unsigned long long>(s_serviceCalls), static_cast<unsigned long long>(s_contextSwitches),
+				static_cast<unsigned long long>(s_ticks));
+		fprintf(output, "job,count,misses,min,avg,max,deadline\n");
+		for (Job *job = s_jobs; job != nullptr; job = job->m_next)
+		{
+			uint64_t minimum = (job->m_count != 0) ? job->m_minimum : 0;
+			uint64_t average = (job->m_count != 0) ? job->m_total / job->m_count : 0;
+			fprintf(output, "%s,%llu,%llu,%llu,%llu,%llu,%llu\n", job->m_name, static_cast<unsigned long long>(job->m_count),
+					static_cast<unsigned long long>(job->m_misses), static_cast<unsigned long long>(minimum), static_cast<unsigned long long>(average),
+					static_cast<unsigned long long>(job->m_maximum), static_cast<unsigned long long>(job->m_deadline));
+		}
+	}
+
+	void Simulation::onServiceCall()
+	{
+		s_serviceCalls++;
+		charge(s_serviceCallCost);
+	}
+
+	void Simulation::onContextSwitch()
+	{
+		s_contextSwitches++;
+		charge(s_contextSwitchCost);
+	}
+
+	void Simulation::onTick()
+	{
+		s_ticks++;
+		charge(s_tickCost);
+	}
+
+	void Simulation::charge(uint32_t cycles)
+	{
+		s_kernelCycles += cycles;
+		s_timer.charge(cycles);
+	}
+
+	void Simulation::finish()
+	{
+		report(stdout);
+		fflush(stdout);
+		exit(0);
+	}
+} // namespace core
+#endif // HOST_SIMULATION
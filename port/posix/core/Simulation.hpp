@@ -0,0 +1,122 @@
+/*MIT License
+
+Copyright (c) 2019 Florian GERARD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Except as contained in this notice, the name of Florian GERARD shall not be used 
+in advertising or otherwise to promote the sale, use or other dealings in this 
+Software without prior written authorization from Florian GERARD
+
+*/
+#pragma once
+#include <cstdint>
+#include <cstdio>
+#include "SimulatedTimer.hpp"
+
+#ifndef HOST_SIM_SVC_CYCLES
+#define HOST_SIM_SVC_CYCLES 0
+#endif
+
+#ifndef HOST_SIM_SWITCH_CYCLES
+#define HOST_SIM_SWITCH_CYCLES 0
+#endif
+
+#ifndef HOST_SIM_TICK_CYCLES
+#define HOST_SIM_TICK_CYCLES 0
+#endif
+
+namespace core
+{
+	/* Discrete event simulation, host port built with HOST_SIMULATION
+	 * Tasks report their execution time with consume, kernel code costs what the cost model says (measure it on target),
+	 * interrupts are injected at given times. Run ends at stop time, or when nothing can happen any more,
+	 * then the report is printed and process exits.
+	 * Busy waits on cycle clock (Api::wait) never end, virtual time does not move while spinning */
+	class Simulation
+	{
+		friend class Core;
+
+	public:
+		/* Response time statistics of a recurring piece of work, usually a task loop
+		 * release and complete bound each job, response time is their distance in cycles */
+		class Job
+		{
+			friend class Simulation;
+
+		public:
+			// deadline relative to release, in cycles, 0 for none
+			Job(const char *name, uint64_t deadline);
+
+			void release();
+			void release(uint64_t time);
+			void complete();
+
+		private:
+			const char *m_name;
+			uint64_t m_deadline;
+			uint64_t m_release;
+			uint64_t m_count;
+			uint64_t m_misses;
+			uint64_t m_minimum;
+			uint64_t m_maximum;
+			uint64_t m_total;
+			Job *m_next;
+		};
+
+		static uint64_t now();
+		//@return time of kernel tick value, e.g. a Periodic release
+		static uint64_t tickTime(uint64_t tick);
+		static uint64_t microseconds(uint64_t us);
+
+		// running task executes for cycles
+		static void consume(uint64_t cycles);
+
+		// raise irq at time, then every period (if not 0) count times (0 for ever), times in cycles
+		static void injectIrq(uint64_t time, Irq irq, uint64_t period = 0, uint32_t count = 1);
+
+		/* load injections from a text file, one per line, '#' starts a comment
+		 * <time us> <irq> [<period us> [<count>]]
+		 *@return false if file cannot be read or a line is malformed */
+		static bool loadScript(const char *path);
+
+		static void stopAt(uint64_t time);
+
+		static void kernelCosts(uint32_t serviceCall, uint32_t contextSwitch, uint32_t tick);
+
+		static void report(FILE *output);
+
+	private:
+		static SimulatedTimer s_timer;
+		static Job *s_jobs;
+		static uint32_t s_serviceCallCost;
+		static uint32_t s_contextSwitchCost;
+		static uint32_t s_tickCost;
+		static uint64_t s_serviceCalls;
+		static uint64_t s_contextSwitches;
+		static uint64_t s_ticks;
+		static uint64_t s_kernelCycles;
+
+		static void onServiceCall();
+		static void onContextSwitch();
+		static void onTick();
+		static void charge(uint32_t cycles);
+		[[noreturn]] static void finish();
+	};
+} // namespace core
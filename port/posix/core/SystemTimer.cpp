@@ -0,0 +1,162 @@
+/*MIT License
+
+Copyright (c) 2019 Florian GERARD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Except as contained in this notice, the name of Florian GERARD shall not be used 
+in advertising or otherwise to promote the sale, use or other dealings in this 
+Software without prior written authorization from Florian GERARD
+
+*/
+#include "SystemTimer.hpp"
+
+#ifndef HOST_SIMULATION
+#include <cerrno>
+#include <csignal>
+#include <ctime>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+namespace core
+{
+	SystemTimer::SystemTimer(VectorManager &vectorManager) : m_vectorManager(vectorManager), m_timer(-1), m_thread(), m_mutex(PTHREAD_MUTEX_INITIALIZER), m_coreFrequency(0), m_period(1000000), m_origin(0), m_countedUntil(0), m_handledUntil(0), m_oneShotStart(0), m_raised(0)
+	{
+	}
+
+	void SystemTimer::initSystemTimer(uint32_t coreFrequency, uint32_t ticksFrequency)
+	{
+		m_coreFrequency = coreFrequency;
+		m_period = 1000000000ull / ticksFrequency;
+		if (m_timer < 0)
+			m_timer = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+	}
+
+	void SystemTimer::startSystemTimer()
+	{
+		m_origin = now();
+		m_countedUntil = m_origin;
+		m_handledUntil = m_origin;
+		arm(m_origin + m_period, m_period);
+		// timer thread must never take interrupt signal
+		sigset_t all, previous;
+		sigfillset(&all);
+		pthread_sigmask(SIG_SETMASK, &all, &previous);
+		pthread_create(&m_thread, nullptr, timerThread, this);
+		pthread_sigmask(SIG_SETMASK, &previous, nullptr);
+	}
+
+	Irq SystemTimer::getIrq()
+	{
+		return -1; // SysTick
+	}
+
+	uint32_t SystemTimer::maxOneShotTicks()
+	{
+		return 0x00FFFFFF;
+	}
+
+	void SystemTimer::startOneShot(uint32_t ticks)
+	{
+		pthread_mutex_lock(&m_mutex);
+		m_oneShotStart = m_countedUntil;
+		m_raised = 0;
+		arm(m_countedUntil + ticks * m_period, 0);
+		pthread_mutex_unlock(&m_mutex);
+	}
+
+	// every period end up to now is reported once: by an interrupt already raised or by the returned count
+	uint32_t SystemTimer::stopOneShot()
+	{
+		pthread_mutex_lock(&m_mutex);
+		uint64_t boundary = periodStart(now());
+		if (boundary < m_countedUntil)
+			boundary = m_countedUntil;
+		uint32_t elapsed = static_cast<uint32_t>((boundary - m_oneShotStart) / m_period) - m_raised;
+		m_countedUntil = boundary;
+		__atomic_store_n(&m_handledUntil, m_handledUntil + elapsed * m_period, __ATOMIC_RELEASE);
+		arm(boundary + m_period, m_period);
+		pthread_mutex_unlock(&m_mutex);
+		return elapsed;
+	}
+
+	uint32_t SystemTimer::cyclesSinceTick()
+	{
+		uint64_t elapsed = now() - __atomic_load_n(&m_handledUntil, __ATOMIC_ACQUIRE);
+		return static_cast<uint32_t>(elapsed * m_coreFrequency / 1000000000ull);
+	}
+
+	// cycles since tick already include periods whose tick is pending
+	bool SystemTimer::isTickPending()
+	{
+		return false;
+	}
+
+	void SystemTimer::acknowledge()
+	{
+		__atomic_store_n(&m_handledUntil, m_handledUntil + m_period, __ATOMIC_RELEASE);
+	}
+
+	uint64_t SystemTimer::now()
+	{
+		timespec time;
+		clock_gettime(CLOCK_MONOTONIC, &time);
+		return static_cast<uint64_t>(time.tv_sec) * 1000000000ull + static_cast<uint64_t>(time.tv_nsec);
+	}
+
+	uint64_t SystemTimer::periodStart(uint64_t time)
+	{
+		return m_origin + ((time - m_origin) / m_period) * m_period;
+	}
+
+	void SystemTimer::arm(uint64_t firstExpiry, uint64_t interval)
+	{
+		itimerspec setting = {};
+		setting.it_value.tv_sec = static_cast<time_t>(firstExpiry / 1000000000ull);
+		setting.it_value.tv_nsec = static_cast<long>(firstExpiry % 1000000000ull);
+		setting.it_interval.tv_sec = static_cast<time_t>(interval / 1000000000ull);
+		setting.it_interval.tv_nsec = static_cast<long>(interval % 1000000000ull);
+		timerfd_settime(m_timer, TFD_TIMER_ABSTIME, &setting, nullptr);
+	}
+
+	void *SystemTimer::timerThread(void *timer)
+	{
+		SystemTimer &self = *static_cast<SystemTimer *>(timer);
+		while (true)
+		{
+			uint64_t expirations;
+			if (read(self.m_timer, &expirations, sizeof(expirations)) != sizeof(expirations))
+			{
+				if (errno == EINTR || errno == EAGAIN)
+					continue;
+				return nullptr;
+			}
+			pthread_mutex_lock(&self.m_mutex);
+			uint64_t boundary = self.periodStart(now());
+			if (boundary > self.m_countedUntil) // not already reported by stopOneShot
+			{
+				self.m_countedUntil = boundary;
+				self.m_raised++;
+				self.m_vectorManager.raise(self.getIrq());
+			}
+			pthread_mutex_unlock(&self.m_mutex);
+		}
+	}
+} // namespace core
+#endif // !HOST_SIMULATION
@@ -0,0 +1,78 @@
+/*MIT License
+
+Copyright (c) 2019 Florian GERARD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Except as contained in this notice, the name of Florian GERARD shall not be used 
+in advertising or otherwise to promote the sale, use or other dealings in this 
+Software without prior written authorization from Florian GERARD
+
+*/
+#pragma once
+#include <cstdint>
+#include <pthread.h>
+#include "yggdrasil/interfaces/ISystemTimer.hpp"
+#include "VectorManager.hpp"
+
+namespace core
+{
+	/* SysTick stand in
+	 * A timerfd expires at each period end, a host thread waits on it and raises the tick interrupt.
+	 * Periods keep the phase of the first one, ticks lost while the process is not scheduled are not replayed.
+ * Cycles since tick count from the last period kernel handled, they do not wrap until its tick is handled:
+ * a host thread cannot wrap the count and set the interrupt pending at once, as hardware does */
+	class SystemTimer : public interfaces::ISystemTimer
+	{
+	public:
+		explicit SystemTimer(VectorManager &vectorManager);
+
+		void initSystemTimer(uint32_t coreFrequency, uint32_t ticksFrequency) override;
+		void startSystemTimer() override;
+		Irq getIrq() override;
+
+		uint32_t maxOneShotTicks() override;
+		void startOneShot(uint32_t ticks) override;
+		uint32_t stopOneShot() override;
+
+		uint32_t cyclesSinceTick() override;
+		bool isTickPending() override;
+
+		// tick interrupt taken, kernel counts one more period
+		void acknowledge();
+
+	private:
+		VectorManager &m_vectorManager;
+		int m_timer;
+		pthread_t m_thread;
+		pthread_mutex_t m_mutex;	   // timer thread against one shot reprogramming
+		uint32_t m_coreFrequency;
+		uint64_t m_period;			   // in ns
+		uint64_t m_origin;			   // start of first period
+		uint64_t volatile m_countedUntil; // end of last period reported to kernel, by interrupt or stopOneShot
+		uint64_t volatile m_handledUntil; // end of last period kernel counted, cycles since tick run from here
+		uint64_t m_oneShotStart;
+		uint32_t m_raised;			   // tick interrupts raised since one shot start
+
+		static uint64_t now();
+		uint64_t periodStart(uint64_t time);
+		void arm(uint64_t firstExpiry, uint64_t interval);
+		static void *timerThread(void *timer);
+	};
+} // namespace core
@@ -0,0 +1,318 @@
+/*MIT License
+
+Copyright (c) 2019 Florian GERARD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Except as contained in this notice, the name of Florian GERARD shall not be used 
+in advertising or otherwise to promote the sale, use or other dealings in this 
+Software without prior written authorization from Florian GERARD
+
+*/
+#include "VectorManager.hpp"
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+
+namespace core
+{
+	VectorManager *VectorManager::s_instance = nullptr;
+
+	VectorManager::VectorManager() : m_pending(), m_nesting(0), m_basePriority(0), m_primask(false), m_subPriorityBits(0), m_installed(false), m_kernelThread()
+	{
+		for (uint32_t vector = 0; vector < vectorCount; vector++)
+		{
+			m_handlers[vector] = defaultHandler;
+			m_priorities[vector] = 0;
+			m_enabled[vector] = vector < 16; // system exceptions are always enabled
+		}
+	}
+
+	void VectorManager::registerHandler(Irq irq, IrqHandler handler, const char *)
+	{
+		m_handlers[vectorOf(irq)] = handler;
+	}
+
+	void VectorManager::unregisterHandler(Irq irq)
+	{
+		m_handlers[vectorOf(irq)] = defaultHandler;
+	}
+
+	uint32_t VectorManager::tableBaseAddress()
+	{
+		return static_cast<uint32_t>(reinterpret_cast<uintptr_t>(m_handlers));
+	}
+
+	VectorManager::IrqHandler VectorManager::getIsr(uint32_t isrNumber)
+	{
+		return (isrNumber < vectorCount) ? m_handlers[isrNumber] : nullptr;
+	}
+
+	void VectorManager::irqPriority(Irq irq, uint8_t preEmptPriority, uint8_t subPriority)
+	{
+		uint8_t subMask = static_cast<uint8_t>((1u << m_subPriorityBits) - 1);
+		m_priorities[vectorOf(irq)] = static_cast<uint8_t>((preEmptPriority << m_subPriorityBits) | (subPriority & subMask));
+	}
+
+	void VectorManager::irqPriority(Irq irq, uint8_t globalPriority)
+	{
+		m_priorities[vectorOf(irq)] = globalPriority;
+	}
+
+	void VectorManager::subPriorityBits(uint8_t numberOfBits)
+	{
+		m_subPriorityBits = (numberOfBits < 8) ? numberOfBits : 7;
+	}
+
+	uint8_t VectorManager::subPriorityBits()
+	{
+		return m_subPriorityBits;
+	}
+
+	void VectorManager::enableIrq(Irq irq)
+	{
+		uint32_t vector = vectorOf(irq);
+		if (vector >= 16)
+			m_enabled[vector] = true;
+		serve();
+	}
+
+	void VectorManager::disableIrq(Irq irq)
+	{
+		uint32_t vector = vectorOf(irq);
+		if (vector >= 16)
+			m_enabled[vector] = false;
+	}
+
+	void VectorManager::clearIrq(Irq irq)
+	{
+		uint32_t vector = vectorOf(irq);
+		__atomic_fetch_and(&m_pending[vector / 32], ~(1u << (vector % 32)), __ATOMIC_SEQ_CST);
+	}
+
+	// like BASEPRI_MAX, mask is only raised
+	uint8_t VectorManager::lockInterruptsHigherThan(uint8_t priority)
+	{
+		uint8_t previous = m_basePriority;
+		if (priority != 0 && (previous == 0 || priority < previous))
+			m_basePriority = priority;
+		return previous;
+	}
+
+	void VectorManager::unlockInterruptsHigherThan(uint8_t priority)
+	{
+		m_basePriority = priority;
+		serve();
+	}
+
+	void VectorManager::lockAllInterrupts()
+	{
+		m_primask = true;
+	}
+
+	void VectorManager::enableAllInterrupts()
+	{
+		m_primask = false;
+		serve();
+	}
+
+	bool VectorManager::isInstalled()
+	{
+		return m_installed;
+	}
+
+	bool VectorManager::installVectorManager()
+	{
+		struct sigaction action = {};
+		action.sa_handler = onSignal;
+		action.sa_flags = SA_RESTART;
+		sigemptyset(&action.sa_mask);
+		sigaddset(&action.sa_mask, HOST_INTERRUPT_SIGNAL);
+		if (sigaction(HOST_INTERRUPT_SIGNAL, &action, nullptr) != 0)
+			return false;
+		s_instance = this;
+		m_kernelThread = pthread_self();
+		m_installed = true;
+		return true;
+	}
+
+	void VectorManager::raise(Irq irq)
+	{
+		uint32_t vector = vectorOf(irq);
+		__atomic_fetch_or(&m_pending[vector / 32], 1u << (vector % 32), __ATOMIC_SEQ_CST);
+		if (!m_installed)
+			return;
+		if (isKernelThread())
+			serve();
+		else
+			pthread_kill(m_kernelThread, HOST_INTERRUPT_SIGNAL);
+	}
+
+	bool VectorManager::isPending(Irq irq)
+	{
+		uint32_t vector = vectorOf(irq);
+		return (__atomic_load_n(&m_pending[vector / 32], __ATOMIC_SEQ_CST) & (1u << (vector % 32))) != 0;
+	}
+
+	bool VectorManager::isAnyPending()
+	{
+		for (uint32_t word = 0; word < (vectorCount + 31) / 32; word++)
+		{
+			uint32_t pending = __atomic_load_n(&m_pending[word], __ATOMIC_SEQ_CST);
+			for (; pending != 0; pending &= pending - 1)
+			{
+				if (m_enabled[word * 32 + __builtin_ctz(pending)])
+					return true;
+			}
+		}
+		return false;
+	}
+
+	uint32_t VectorManager::activeVector()
+	{
+		return (m_nesting != 0) ? m_active[m_nesting - 1] : 0;
+	}
+
+	// new task context starts with interrupt signal blocked, as handler that switched to it left it
+	void VectorManager::exceptionReturn()
+	{
+		m_nesting = 0;
+		dispatch();
+		sigset_t previous;
+		unblockInterruptSignal(&previous);
+	}
+
+	void VectorManager::serve()
+	{
+		sigset_t previous;
+		blockInterruptSignal(&previous);
+		dispatch();
+		restoreInterruptSignal(&previous);
+	}
+
+	// simulation raises everything from kernel thread, signal is never sent and masking it is only a cost
+	void VectorManager::blockInterruptSignal(sigset_t *previous)
+	{
+#ifndef HOST_SIMULATION
+		sigset_t signal;
+		sigemptyset(&signal);
+		sigaddset(&signal, HOST_INTERRUPT_SIGNAL);
+		pthread_sigmask(SIG_BLOCK, &signal, previous);
+#else
+		(void)previous;
+#endif
+	}
+
+	void VectorManager::unblockInterruptSignal(sigset_t *previous)
+	{
+#ifndef HOST_SIMULATION
+		sigset_t signal;
+		sigemptyset(&signal);
+		sigaddset(&signal, HOST_INTERRUPT_SIGNAL);
+		pthread_sigmask(SIG_UNBLOCK, &signal, previous);
+#else
+		(void)previous;
+#endif
+	}
+
+	void VectorManager::restoreInterruptSignal(const sigset_t *previous)
+	{
+#ifndef HOST_SIMULATION
+		pthread_sigmask(SIG_SETMASK, previous, nullptr);
+#else
+		(void)previous;
+#endif
+	}
+
+	uint32_t VectorManager::vectorOf(Irq irq)
+	{
+		int32_t vector = static_cast<int16_t>(irq) + 16;
+		if (vector < 0 || vector >= static_cast<int32_t>(vectorCount))
+		{
+			fprintf(stderr, "yggdrasil: irq %d out of simulated vector table\n", vector - 16);
+			abort();
+		}
+		return static_cast<uint32_t>(vector);
+	}
+
+	void VectorManager::defaultHandler()
+	{
+		fprintf(stderr, "yggdrasil: unhandled irq %d\n", static_cast<int32_t>(s_instance->activeVector()) - 16);
+		abort();
+	}
+
+	void VectorManager::onSignal(int)
+	{
+		int savedErrno = errno;
+		if (s_instance != nullptr)
+			s_instance->dispatch();
+		errno = savedErrno;
+	}
+
+	bool VectorManager::isKernelThread()
+	{
+		return pthread_equal(pthread_self(), m_kernelThread) != 0;
+	}
+
+	// called with interrupt signal blocked, handlers run with it unblocked so more urgent interrupts preempt them
+	void VectorManager::dispatch()
+	{
+		int32_t vector;
+		while ((vector = nextVector()) >= 0)
+		{
+			__atomic_fetch_and(&m_pending[vector / 32], ~(1u << (vector % 32)), __ATOMIC_SEQ_CST);
+			if (m_nesting >= maxNesting)
+			{
+				fprintf(stderr, "yggdrasil: interrupt nesting too deep\n");
+				abort();
+			}
+			m_active[m_nesting] = static_cast<uint32_t>(vector);
+			m_nesting = m_nesting + 1;
+			sigset_t previous;
+			unblockInterruptSignal(&previous);
+			m_handlers[vector]();
+			restoreInterruptSignal(&previous);
+			m_nesting = m_nesting - 1;
+		}
+	}
+
+	//@return most urgent pending vector allowed to run now, -1 if none
+	int32_t VectorManager::nextVector()
+	{
+		if (m_primask)
+			return -1;
+		uint16_t activeGroup = (m_nesting != 0) ? (m_priorities[m_active[m_nesting - 1]] >> m_subPriorityBits) : threadPriority;
+		uint16_t maskGroup = (m_basePriority != 0) ? (m_basePriority >> m_subPriorityBits) : threadPriority;
+		int32_t best = -1;
+		for (uint32_t word = 0; word < (vectorCount + 31) / 32; word++)
+		{
+			uint32_t pending = __atomic_load_n(&m_pending[word], __ATOMIC_SEQ_CST);
+			for (; pending != 0; pending &= pending - 1)
+			{
+				uint32_t vector = word * 32 + __builtin_ctz(pending);
+				uint16_t group = m_priorities[vector] >> m_subPriorityBits;
+				if (!m_enabled[vector] || group >= activeGroup || group >= maskGroup)
+					continue;
+				if (best < 0 || m_priorities[vector] < m_priorities[best]) // same priority, lowest vector first
+					best = static_cast<int32_t>(vector);
+			}
+		}
+		return best;
+	}
+} // namespace core
@@ -0,0 +1,117 @@
+/*MIT License
+
+Copyright (c) 2019 Florian GERARD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Except as contained in this notice, the name of Florian GERARD shall not be used 
+in advertising or otherwise to promote the sale, use or other dealings in this 
+Software without prior written authorization from Florian GERARD
+
+*/
+#pragma once
+#include <cstdint>
+#include <pthread.h>
+#include <signal.h>
+#include "yggdrasil/interfaces/IVectorsManager.hpp"
+
+#ifndef HOST_EXTERNAL_IRQS
+#define HOST_EXTERNAL_IRQS 64
+#endif
+
+#ifndef HOST_INTERRUPT_SIGNAL
+#define HOST_INTERRUPT_SIGNAL SIGUSR1
+#endif
+
+namespace core
+{
+	using Irq = interfaces::Irq;
+
+	/* Simulated NVIC
+	 * Pending interrupts are taken by the kernel thread, whenever they are raised from this thread
+	 * or a signal announces them from another one. Priority, BASEPRI and PRIMASK rules follow Cortex-M:
+	 * a handler runs only if more urgent than the active one and not masked.
+	 * Interrupt signal is blocked while simulator state changes, handlers run with it unblocked so they can be preempted */
+	class VectorManager : public interfaces::IVectorManager
+	{
+	public:
+		static constexpr uint32_t vectorCount = 16 + HOST_EXTERNAL_IRQS; // exceptions first, like vector table
+		static constexpr uint16_t threadPriority = 0x100;				  // below every interrupt
+
+		VectorManager();
+
+		void registerHandler(Irq irq, IrqHandler handler, const char *name = nullptr) override;
+		void unregisterHandler(Irq irq) override;
+		uint32_t tableBaseAddress() override;
+		IrqHandler getIsr(uint32_t isrNumber) override;
+		void irqPriority(Irq irq, uint8_t preEmptPriority, uint8_t subPriority) override;
+		void irqPriority(Irq irq, uint8_t globalPriority) override;
+		void subPriorityBits(uint8_t numberOfBits) override;
+		uint8_t subPriorityBits() override;
+		void enableIrq(Irq irq) override;
+		void disableIrq(Irq irq) override;
+		void clearIrq(Irq irq) override;
+		uint8_t lockInterruptsHigherThan(uint8_t priority) override;
+		void unlockInterruptsHigherThan(uint8_t priority) override;
+		void lockAllInterrupts() override;
+		void enableAllInterrupts() override;
+		bool isInstalled() override;
+		bool installVectorManager() override;
+
+		// set interrupt pending, safe from any host thread and from signal handlers
+		void raise(Irq irq);
+		bool isPending(Irq irq);
+		// true if an enabled interrupt is pending, whatever masks say
+		bool isAnyPending();
+		//@return active vector number, 0 in thread mode
+		uint32_t activeVector();
+		// go back to thread mode from the handler that started a new task, take pending interrupts
+		void exceptionReturn();
+		// take pending interrupts allowed by masks and active priority
+		void serve();
+
+		static void blockInterruptSignal(sigset_t *previous);
+		static void unblockInterruptSignal(sigset_t *previous);
+		static void restoreInterruptSignal(const sigset_t *previous);
+
+	private:
+		static constexpr uint32_t maxNesting = 16;
+
+		IrqHandler m_handlers[vectorCount];
+		uint8_t m_priorities[vectorCount];
+		bool m_enabled[vectorCount];
+		uint32_t volatile m_pending[(vectorCount + 31) / 32];
+		uint32_t m_active[maxNesting];
+		uint32_t volatile m_nesting;
+		uint8_t volatile m_basePriority;
+		bool volatile m_primask;
+		uint8_t m_subPriorityBits;
+		bool m_installed;
+		pthread_t m_kernelThread;
+
+		static VectorManager *s_instance;
+
+		static uint32_t vectorOf(Irq irq);
+		static void defaultHandler();
+		static void onSignal(int);
+		bool isKernelThread();
+		void dispatch();
+		int32_t nextVector();
+	};
+} // namespace core
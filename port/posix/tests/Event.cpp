@@ -0,0 +1,115 @@
+/*MIT License
+
+Copyright (c) 2019 Florian GERARD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Except as contained in this notice, the name of Florian GERARD shall not be used 
+in advertising or otherwise to promote the sale, use or other dealings in this 
+Software without prior written authorization from Florian GERARD
+
+*/
+#include "core/Core.hpp"
+#include "yggdrasil/kernel/Api.hpp"
+#include "yggdrasil/kernel/Event.hpp"
+#include "HostTest.hpp"
+
+/* Event modes, on virtual time
+ * manual reset: one signal releases every waiter highest priority first, event stays raised until reset
+ * auto reset: a second waiter is refused, a signal releases the single waiter and is consumed,
+ * a signal without waiter is kept for the next wait only */
+
+using namespace kernel;
+
+namespace
+{
+	constexpr uint32_t waiterCount = 3;
+
+	Task<512> manualWaiters[waiterCount], autoWaiter, refusedWaiter, driver;
+	Event manual(false, "manual", Event::Mode::manualReset);
+	Event automatic(false, "auto", Event::Mode::autoReset);
+
+	volatile uint32_t manualWoken = 0;
+	volatile uint32_t manualOrder[waiterCount]; // priorities of released waiters, in wake up order
+	volatile uint32_t autoWoken = 0;
+	volatile int16_t refusedResult = 1;
+
+	void manualWaiterTask(uint32_t priority)
+	{
+		HOST_CHECK(manual.wait() == 1);
+		manualOrder[manualWoken] = priority;
+		manualWoken = manualWoken + 1;
+	}
+
+	void autoWaiterTask(uint32_t)
+	{
+		Api::sleep(10);
+		HOST_CHECK(automatic.wait() == 1);
+		autoWoken = autoWoken + 1;
+	}
+
+	void refusedWaiterTask(uint32_t)
+	{
+		Api::sleep(11); // after autoWaiter
+		refusedResult = automatic.wait(5);
+	}
+
+	void driverTask(uint32_t)
+	{
+		Api::sleep(1); // every manual waiter blocks
+		HOST_CHECK(manual.signal());
+		HOST_CHECK(manualWoken == 0); // released waiters are only ready while driver runs
+		HOST_CHECK(!manual.someoneWaiting());
+		Api::sleep(1);
+		HOST_CHECK(manualWoken == waiterCount);
+		HOST_CHECK(manualOrder[0] == 3 && manualOrder[1] == 2 && manualOrder[2] == 1);
+		HOST_CHECK(manual.isAlreadyUp()); // stays raised
+		HOST_CHECK(manual.wait(1) == 1); // and does not reset on wait
+		HOST_CHECK(manual.isAlreadyUp());
+		manual.reset();
+		HOST_CHECK(manual.wait(2) == -1);
+
+		Api::sleep(20); // autoWaiter blocks, refusedWaiter is refused
+		HOST_CHECK(refusedResult == 0);
+		HOST_CHECK(automatic.someoneWaiting());
+		HOST_CHECK(automatic.signal());
+		Api::sleep(1);
+		HOST_CHECK(autoWoken == 1);
+		HOST_CHECK(!automatic.isAlreadyUp()); // signal consumed by the waiter
+
+		HOST_CHECK(automatic.signal()); // nobody waits, kept
+		HOST_CHECK(automatic.isAlreadyUp());
+		HOST_CHECK(automatic.wait(1) == 1);
+		HOST_CHECK(!automatic.isAlreadyUp());
+		HOST_CHECK(automatic.wait(2) == -1);
+		hosttest::finish("event");
+	}
+} // namespace
+
+int main()
+{
+	Api::setupKernel(1);
+	for (uint32_t i = 0; i < waiterCount; i++)
+		manualWaiters[i].start(manualWaiterTask, true, i + 1, i + 1);
+	autoWaiter.start(autoWaiterTask, true, 1);
+	refusedWaiter.start(refusedWaiterTask, true, 2);
+	driver.start(driverTask, true, 5);
+	Api::startKernel();
+	return 1;
+}
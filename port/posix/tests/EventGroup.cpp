@@ -0,0 +1,129 @@
+/*MIT License
+
+Copyright (c) 2019 Florian GERARD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Except as contained in this notice, the name of Florian GERARD shall not be used 
+in advertising or otherwise to promote the sale, use or other dealings in this 
+Software without prior written authorization from Florian GERARD
+
+*/
+#include "core/Core.hpp"
+#include "yggdrasil/kernel/Api.hpp"
+#include "yggdrasil/kernel/EventGroup.hpp"
+#include "HostTest.hpp"
+
+/* Event group wake path, on virtual time
+ * a set satisfying nobody wakes nobody, a single set releases every satisfied waiter (waitAll, waitAny, two clear on exit
+ * waiters whose masks overlap), each one gets the flags before clearing and the union of clear masks is cleared once,
+ * an already satisfied wait returns without waiting, a wait not satisfied in time returns 0 and leaves flags as they are */
+
+using namespace kernel;
+
+namespace
+{
+	constexpr uint32_t waiterCount = 4;
+	constexpr uint32_t allMask = 0x03;
+	constexpr uint32_t anyMask = 0x04;
+	constexpr uint32_t clearMaskA = 0x18;
+	constexpr uint32_t clearMaskB = 0x30; // shares 0x10 with clearMaskA
+
+	Task<512> allWaiter, anyWaiter, clearWaiterA, clearWaiterB, timedWaiter, driver;
+	EventGroup group(0, "group");
+
+	volatile uint32_t wokenCount = 0;
+	volatile uint32_t wokenOrder[waiterCount]; // priorities, in wake up order
+	volatile uint32_t results[waiterCount + 1]; // by priority
+	volatile bool timedDone = false;
+
+	void woken(uint32_t priority, uint32_t flags)
+	{
+		results[priority] = flags;
+		wokenOrder[wokenCount] = priority;
+		wokenCount = wokenCount + 1;
+	}
+
+	void allWaiterTask(uint32_t priority)
+	{
+		woken(priority, group.waitAll(allMask));
+	}
+
+	void anyWaiterTask(uint32_t priority)
+	{
+		woken(priority, group.waitAny(anyMask));
+	}
+
+	void clearWaiterTask(uint32_t priority)
+	{
+		woken(priority, group.waitAny(priority == 3 ? clearMaskA : clearMaskB, true));
+	}
+
+	void timedWaiterTask(uint32_t)
+	{
+		Api::sleep(10);
+		HOST_CHECK(group.waitAll(0x300, false, 20) == 0);
+		timedDone = true;
+	}
+
+	void driverTask(uint32_t)
+	{
+		Api::sleep(1); // every waiter blocks
+		HOST_CHECK(group.set(0x01)); // half of allMask only
+		Api::sleep(1);
+		HOST_CHECK(wokenCount == 0);
+		HOST_CHECK(group.get() == 0x01);
+
+		HOST_CHECK(group.set(0x16));
+		HOST_CHECK(group.get() == 0x07); // 0x17 without clear masks of both clear waiters
+		HOST_CHECK(!group.someoneWaiting());
+		Api::sleep(1);
+		HOST_CHECK(wokenCount == waiterCount);
+		HOST_CHECK(wokenOrder[0] == 4 && wokenOrder[1] == 3 && wokenOrder[2] == 2 && wokenOrder[3] == 1);
+		for (uint32_t priority = 1; priority <= waiterCount; priority++)
+			HOST_CHECK(results[priority] == 0x17); // flags seen by the set, before clearing
+
+		HOST_CHECK(group.waitAny(0x01, true) == 0x07); // already satisfied
+		HOST_CHECK(group.get() == 0x06);
+		HOST_CHECK(group.waitAll(0x0E, false, 2) == 0); // 0x08 missing
+		HOST_CHECK(group.get() == 0x06);
+
+		Api::sleep(10); // timed waiter blocks
+		HOST_CHECK(group.set(0x100)); // half of its mask
+		HOST_CHECK(group.someoneWaiting());
+		Api::sleep(20);
+		HOST_CHECK(timedDone);
+		HOST_CHECK(!group.someoneWaiting());
+		HOST_CHECK(group.get() == 0x106);
+		hosttest::finish("event group");
+	}
+} // namespace
+
+int main()
+{
+	Api::setupKernel(1);
+	allWaiter.start(allWaiterTask, true, 1, 1);
+	anyWaiter.start(anyWaiterTask, true, 2, 2);
+	clearWaiterA.start(clearWaiterTask, true, 3, 3);
+	clearWaiterB.start(clearWaiterTask, true, 4, 4);
+	timedWaiter.start(timedWaiterTask, true, 5);
+	driver.start(driverTask, true, 6);
+	Api::startKernel();
+	return 1;
+}
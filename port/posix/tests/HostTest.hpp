@@ -0,0 +1,63 @@
+/*MIT License
+
+Copyright (c) 2019 Florian GERARD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Except as contained in this notice, the name of Florian GERARD shall not be used 
+in advertising or otherwise to promote the sale, use or other dealings in this 
+Software without prior written authorization from Florian GERARD
+
+*/
+#pragma once
+#include <cstdint>
+#include <cstdio>
+#include <unistd.h>
+
+/* Helpers of host port tests
+ * checks are counted from tasks and reported once by finish, tasks may be switched inside stdio */
+namespace hosttest
+{
+	inline volatile uint32_t s_failures = 0;
+	inline const char *volatile s_firstFailure = nullptr;
+	inline volatile uint32_t s_firstFailureLine = 0;
+
+	inline void fail(const char *condition, uint32_t line)
+	{
+		if (s_failures == 0)
+		{
+			s_firstFailure = condition;
+			s_firstFailureLine = line;
+		}
+		s_failures = s_failures + 1;
+	}
+
+	// print result and end process, exit status is the test result
+	[[noreturn]] inline void finish(const char *name)
+	{
+		if (s_failures != 0)
+			printf("%s: %u failed checks, first one line %u: %s\n", name, s_failures, s_firstFailureLine, s_firstFailure);
+		else
+			printf("%s: passed\n", name);
+		fflush(stdout);
+		_exit(s_failures != 0 ? 1 : 0);
+	}
+} // namespace hosttest
+
+#define HOST_CHECK(condition) ((condition) ? (void)0 : hosttest::fail(#condition, __LINE__))
@@ -0,0 +1,142 @@
+/*MIT License
+
+Copyright (c) 2019 Florian GERARD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Except as contained in this notice, the name of Florian GERARD shall not be used 
+in advertising or otherwise to promote the sale, use or other dealings in this 
+Software without prior written authorization from Florian GERARD
+
+*/
+#include <chrono>
+#include <thread>
+#include "core/Core.hpp"
+#include "yggdrasil/kernel/Api.hpp"
+#include "yggdrasil/kernel/Event.hpp"
+#include "yggdrasil/kernel/Mutex.hpp"
+#include "yggdrasil/kernel/Semaphore.hpp"
+#include "HostTest.hpp"
+
+/* Kernel running on host timer: event ping pong, sleeps, mutex contention, interrupts raised from another host thread */
+
+using namespace kernel;
+
+namespace
+{
+	constexpr core::interfaces::Irq testIrq = 3;
+
+	Task<512> ping, pong, sleeper, locker1, locker2, isrWaiter, checker;
+	Event pingEvent, pongEvent;
+	Mutex mutex;
+	Semaphore isrSemaphore(0);
+	volatile uint32_t pings = 0, sleeps = 0, locks = 0, shared = 0, isrHits = 0;
+
+	void pingTask(uint32_t)
+	{
+		while (true)
+		{
+			pingEvent.signal();
+			pongEvent.wait();
+			pings = pings + 1;
+		}
+	}
+
+	void pongTask(uint32_t)
+	{
+		while (true)
+		{
+			pingEvent.wait();
+			pongEvent.signal();
+		}
+	}
+
+	void sleeperTask(uint32_t)
+	{
+		while (true)
+		{
+			uint64_t before = Api::getTicks();
+			Api::sleep(10);
+			HOST_CHECK(Api::getTicks() >= before + 10);
+			sleeps = sleeps + 1;
+		}
+	}
+
+	void lockerTask(uint32_t)
+	{
+		while (true)
+		{
+			mutex.lock();
+			uint32_t value = shared;
+			Api::yield(); // other locker runs and blocks on mutex
+			HOST_CHECK(shared == value);
+			shared = value + 1;
+			locks = locks + 1;
+			mutex.release();
+			Api::sleep(1);
+		}
+	}
+
+	void isrWaiterTask(uint32_t)
+	{
+		while (true)
+		{
+			if (isrSemaphore.take(1000) > 0)
+				isrHits = isrHits + 1;
+		}
+	}
+
+	void checkerTask(uint32_t)
+	{
+		Api::sleep(500);
+		HOST_CHECK(pings > 100);
+		HOST_CHECK(sleeps >= 10);
+		HOST_CHECK(locks > 100);
+		HOST_CHECK(isrHits > 10);
+		hosttest::finish("kernel smoke");
+	}
+
+	void irqHandler()
+	{
+		isrSemaphore.giveFromIsr();
+	}
+} // namespace
+
+int main()
+{
+	Api::setupKernel(1);
+	ping.start(pingTask, true, 2);
+	pong.start(pongTask, true, 2);
+	sleeper.start(sleeperTask, true, 5);
+	locker1.start(lockerTask, true, 3);
+	locker2.start(lockerTask, true, 3);
+	isrWaiter.start(isrWaiterTask, true, 6);
+	checker.start(checkerTask, true, 7);
+	Api::setupInterrupt(testIrq, irqHandler, 4);
+	Api::enableIrq(testIrq);
+	std::thread([] {
+		while (true)
+		{
+			std::this_thread::sleep_for(std::chrono::microseconds(500));
+			core::Core::raiseIrq(testIrq);
+		}
+	}).detach();
+	Api::startKernel();
+	return 1;
+}
@@ -0,0 +1,258 @@
+/*MIT License
+
+Copyright (c) 2019 Florian GERARD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Except as contained in this notice, the name of Florian GERARD shall not be used 
+in advertising or otherwise to promote the sale, use or other dealings in this 
+Software without prior written authorization from Florian GERARD
+
+*/
+#include "core/Core.hpp"
+#include "yggdrasil/kernel/Api.hpp"
+#include "yggdrasil/kernel/MessageQueue.hpp"
+#include "yggdrasil/kernel/Semaphore.hpp"
+#include "HostTest.hpp"
+
+/* Message queue, on virtual time, a service call costs one cycle so that time counts them
+ * 1: interrupt sends with the interrupt request ring full: messages are kept and received in order,
+ *    queue goes on working through wraparound afterwards
+ * 2: send and receive without waiter never call kernel
+ * 3: send on full queue and receive on empty queue time out
+ * 4: waiting receiver and sender are handed their slot in order
+ * 5: a message committed before an older one is received after it */
+
+using namespace kernel;
+using core::Simulation;
+
+namespace
+{
+	constexpr core::interfaces::Irq testIrq = 3;
+	constexpr uint32_t capacity = 32;
+	constexpr uint32_t lateBurst = 4;  // sent once the ring is full
+	constexpr uint32_t longBurst = 24; // overflows the ring by itself
+	constexpr uint32_t exchanged = 3 * capacity;
+	constexpr uint32_t firstPhaseMessages = lateBurst + 1 + longBurst + exchanged;
+	constexpr uint32_t smallCapacity = 4;
+	constexpr uint32_t laps = 10;
+	constexpr uint32_t phaseBlocking = 60; // ticks
+	constexpr uint32_t phaseOrder = 100;
+	constexpr uint32_t slowCommit = 5; // ticks
+
+	// message taking time to construct, its slot is reserved meanwhile
+	struct Stamped
+	{
+		uint32_t value;
+
+		Stamped() : value(0)
+		{
+		}
+
+		Stamped(uint32_t stamp, uint32_t delay) : value(stamp)
+		{
+			if (delay != 0)
+				Api::sleep(delay);
+		}
+	};
+
+	Task<512> receiver, sender, driver, consumer, producer, slowSender, fastSender, orderReceiver, checker;
+	MessageQueue<uint32_t, capacity> queue;
+	MessageQueue<uint32_t, smallCapacity> small;
+	MessageQueue<Stamped, smallCapacity> stamped;
+	Semaphore filler(0, 1000);
+
+	volatile uint32_t irqCount = 0;
+	volatile uint32_t nextValue = 0; // next value sent, from interrupt or task
+	volatile uint32_t received = 0;
+	volatile bool ringWasFull = false;
+	volatile bool outOfOrder = false;
+	volatile uint64_t fastPathCalls = UINT64_MAX;
+	volatile uint32_t consumed = UINT32_MAX;
+	volatile uint32_t stampOrder[2] = {};
+	volatile bool phasesDone = false;
+
+	uint32_t takeValue()
+	{
+		uint32_t value = nextValue;
+		nextValue = value + 1;
+		return value;
+	}
+
+	void irqHandler()
+	{
+		irqCount = irqCount + 1;
+		if (irqCount == 1)
+		{
+			for (uint32_t i = 0; i < config::isrRequestSlots; i++)
+				filler.giveFromIsr();
+			for (uint32_t i = 0; i < lateBurst; i++)
+				HOST_CHECK(queue.sendFromIsr(takeValue()));
+			ringWasFull = !filler.giveFromIsr();
+		}
+		else
+		{
+			for (uint32_t i = 0; i < longBurst; i++)
+				HOST_CHECK(queue.sendFromIsr(takeValue()));
+		}
+	}
+
+	void receiverTask(uint32_t)
+	{
+		while (received < firstPhaseMessages)
+		{
+			uint32_t value;
+			if (queue.receive(value, 50) < 0)
+				continue;
+			if (value != received)
+				outOfOrder = true;
+			received = received + 1;
+		}
+	}
+
+	void senderTask(uint32_t)
+	{
+		// first burst is not handed to waiting receiver until a send wakes it
+		Api::sleep(10);
+		HOST_CHECK(received == 0);
+		HOST_CHECK(queue.count() == lateBurst);
+		queue.send(takeValue());
+		Api::sleep(2);
+		HOST_CHECK(received == lateBurst + 1);
+
+		// second burst wakes receiver with the first request that got through
+		Api::sleep(20);
+		HOST_CHECK(received == lateBurst + 1 + longBurst);
+
+		for (uint32_t i = 0; i < exchanged; i++)
+			queue.send(takeValue());
+	}
+
+	void driverTask(uint32_t)
+	{
+		Api::sleep(phaseBlocking);
+
+		// 2: fast paths, across several laps
+		uint64_t start = Simulation::now();
+		uint32_t value = 0;
+		for (uint32_t lap = 0; lap < laps; lap++)
+		{
+			for (uint32_t i = 0; i < smallCapacity; i++)
+				HOST_CHECK(small.send(lap * smallCapacity + i) == 1);
+			HOST_CHECK(small.count() == smallCapacity);
+			for (uint32_t i = 0; i < smallCapacity; i++)
+			{
+				HOST_CHECK(small.receive(value) == 1);
+				HOST_CHECK(value == lap * smallCapacity + i);
+			}
+		}
+		fastPathCalls = Simulation::now() - start;
+
+		// 3: timeouts
+		uint64_t ticks = Api::getTicks();
+		HOST_CHECK(small.receive(value, 5) == -1);
+		HOST_CHECK(Api::getTicks() >= ticks + 5);
+		for (uint32_t i = 0; i < smallCapacity; i++)
+			small.send(i);
+		ticks = Api::getTicks();
+		HOST_CHECK(small.send(smallCapacity, 5) == -1);
+		HOST_CHECK(Api::getTicks() >= ticks + 5);
+		HOST_CHECK(small.count() == smallCapacity);
+
+		// 4: producer waits on full queue, one receive hands it the freed slot, its message is the last one
+		producer.start([](uint32_t) { small.send(smallCapacity); }, true, 5);
+		HOST_CHECK(small.someoneWaiting());
+		for (uint32_t i = 0; i <= smallCapacity; i++)
+		{
+			HOST_CHECK(small.receive(value, 5) == 1);
+			HOST_CHECK(value == i);
+		}
+		HOST_CHECK(!small.someoneWaiting());
+		// consumer waits on empty queue and gets message as soon as it is sent
+		consumer.start([](uint32_t) {
+			uint32_t message;
+			if (small.receive(message) == 1)
+				consumed = message;
+		}, true, 5);
+		HOST_CHECK(small.someoneWaiting());
+		small.send(42);
+		HOST_CHECK(consumed == 42);
+	}
+
+	// 5: slow sender reserves first and commits last
+	void slowSenderTask(uint32_t)
+	{
+		Api::sleep(phaseOrder);
+		stamped.emplace(0, 1u, slowCommit);
+	}
+
+	void fastSenderTask(uint32_t)
+	{
+		Api::sleep(phaseOrder + 1);
+		stamped.emplace(0, 2u, 0u);
+		HOST_CHECK(stampOrder[0] == 0); // committed, but behind slow message
+	}
+
+	void orderReceiverTask(uint32_t)
+	{
+		Api::sleep(phaseOrder);
+		for (uint32_t i = 0; i < 2; i++)
+		{
+			Stamped message;
+			if (stamped.receive(message, 50) == 1)
+				stampOrder[i] = message.value;
+		}
+		phasesDone = true;
+	}
+
+	void checkerTask(uint32_t)
+	{
+		Api::sleep(phaseOrder + 50);
+		HOST_CHECK(ringWasFull);
+		HOST_CHECK(irqCount == 2);
+		HOST_CHECK(received == firstPhaseMessages);
+		HOST_CHECK(!outOfOrder);
+		HOST_CHECK(queue.count() == 0);
+		HOST_CHECK(fastPathCalls == 0);
+		HOST_CHECK(consumed == 42);
+		HOST_CHECK(phasesDone);
+		HOST_CHECK(stampOrder[0] == 1);
+		HOST_CHECK(stampOrder[1] == 2);
+		hosttest::finish("message queue");
+	}
+} // namespace
+
+int main()
+{
+	Api::setupKernel(1);
+	Simulation::kernelCosts(1, 0, 0);
+	receiver.start(receiverTask, true, 3);
+	sender.start(senderTask, true, 2);
+	driver.start(driverTask, true, 3);
+	slowSender.start(slowSenderTask, true, 4);
+	fastSender.start(fastSenderTask, true, 4);
+	orderReceiver.start(orderReceiverTask, true, 6);
+	checker.start(checkerTask, true, 7);
+	Api::setupInterrupt(testIrq, irqHandler, 4);
+	Api::enableIrq(testIrq);
+	Simulation::injectIrq(Simulation::microseconds(5000), testIrq);
+	Simulation::injectIrq(Simulation::microseconds(20000), testIrq);
+	Api::startKernel();
+	return 1;
+}
@@ -0,0 +1,178 @@
+/*MIT License
+
+Copyright (c) 2019 Florian GERARD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Except as contained in this notice, the name of Florian GERARD shall not be used 
+in advertising or otherwise to promote the sale, use or other dealings in this 
+Software without prior written authorization from Florian GERARD
+
+*/
+#include "core/Core.hpp"
+#include "yggdrasil/kernel/Api.hpp"
+#include "yggdrasil/kernel/Mutex.hpp"
+#include "HostTest.hpp"
+
+/* Mutex and CeilingMutex held together, on virtual time
+ * each phase starts on its own tick, a flag records whether a task ran while an other one was expected to keep the cpu:
+ * A: a contended Mutex released under a ceiling must not drop its owner below that ceiling
+ * B: a ceiling released while a Mutex is inherited from must keep the inherited priority
+ * C: nested ceilings give back the outer ceiling, not the base priority
+ * D: releasing an inner ceiling lower than the outer one keeps the outer ceiling, medium only runs once outer is released */
+
+using namespace kernel;
+using core::Simulation;
+
+namespace
+{
+	constexpr uint32_t phaseA = 10; // ticks
+	constexpr uint32_t phaseB = 30;
+	constexpr uint32_t phaseC = 50;
+	constexpr uint32_t phaseD = 70;
+
+	Task<512> aLow, aWaiter, bLow, bHigh, bMedium, cLow, cMedium, dLow, dMedium, checker;
+	Mutex mutexA, mutexB;
+	CeilingMutex ceilingA(4), ceilingB(3), innerC(5), outerC(3), innerD(3), outerD(5);
+
+	volatile bool waiterRan = false, waiterRanInCeiling = true;
+	volatile bool mediumBRan = false, mediumBRanInMutex = true;
+	volatile bool mediumCRan = false, mediumCRanAfterInner = false, mediumCRanInOuter = true;
+	volatile bool mediumDRan = false, mediumDRanAfterInner = true;
+
+	void consumeTicks(uint32_t ticks)
+	{
+		Simulation::consume(Simulation::microseconds(1000 * ticks));
+	}
+
+	// A: low inherits waiter priority on mutexA then takes ceilingA, releasing mutexA gives it to waiter
+	void aLowTask(uint32_t)
+	{
+		Api::sleep(phaseA);
+		mutexA.lock();
+		consumeTicks(3); // waiter blocks on mutexA
+		ceilingA.lock();
+		mutexA.release();
+		consumeTicks(1);
+		waiterRanInCeiling = waiterRan;
+		ceilingA.release();
+	}
+
+	void aWaiterTask(uint32_t)
+	{
+		Api::sleep(phaseA + 1);
+		mutexA.lock();
+		waiterRan = true;
+		mutexA.release();
+	}
+
+	// B: high blocks on mutexB owned by low which runs under ceilingB, medium is ready between both priorities
+	void bLowTask(uint32_t)
+	{
+		Api::sleep(phaseB);
+		mutexB.lock();
+		ceilingB.lock();
+		consumeTicks(5); // high blocks on mutexB, medium becomes ready
+		ceilingB.release();
+		consumeTicks(1);
+		mediumBRanInMutex = mediumBRan;
+		mutexB.release();
+	}
+
+	void bHighTask(uint32_t)
+	{
+		Api::sleep(phaseB + 1);
+		mutexB.lock();
+		mutexB.release();
+	}
+
+	void bMediumTask(uint32_t)
+	{
+		Api::sleep(phaseB + 2);
+		mediumBRan = true;
+	}
+
+	// C: inner ceiling above medium, outer one below, releasing inner lets medium run at once
+	void cLowTask(uint32_t)
+	{
+		Api::sleep(phaseC);
+		outerC.lock();
+		innerC.lock();
+		consumeTicks(3); // medium becomes ready
+		mediumCRanInOuter = mediumCRan;
+		innerC.release();
+		mediumCRanAfterInner = mediumCRan;
+		outerC.release();
+	}
+
+	void cMediumTask(uint32_t)
+	{
+		Api::sleep(phaseC + 1);
+		mediumCRan = true;
+	}
+
+	// D: inner ceiling below outer one, releasing it keeps outer ceiling above medium
+	void dLowTask(uint32_t)
+	{
+		Api::sleep(phaseD);
+		outerD.lock();
+		innerD.lock();
+		consumeTicks(3); // medium becomes ready
+		innerD.release();
+		mediumDRanAfterInner = mediumDRan;
+		outerD.release();
+	}
+
+	void dMediumTask(uint32_t)
+	{
+		Api::sleep(phaseD + 1);
+		mediumDRan = true;
+	}
+
+	void checkerTask(uint32_t)
+	{
+		Api::sleep(phaseD + 20);
+		HOST_CHECK(waiterRan);
+		HOST_CHECK(!waiterRanInCeiling);
+		HOST_CHECK(mediumBRan);
+		HOST_CHECK(!mediumBRanInMutex);
+		HOST_CHECK(!mediumCRanInOuter);
+		HOST_CHECK(mediumCRanAfterInner);
+		HOST_CHECK(mediumDRan);
+		HOST_CHECK(!mediumDRanAfterInner);
+		hosttest::finish("mutex priorities");
+	}
+} // namespace
+
+int main()
+{
+	Api::setupKernel(1);
+	aLow.start(aLowTask, true, 1);
+	aWaiter.start(aWaiterTask, true, 2);
+	bLow.start(bLowTask, true, 1);
+	bHigh.start(bHighTask, true, 5);
+	bMedium.start(bMediumTask, true, 4);
+	cLow.start(cLowTask, true, 1);
+	cMedium.start(cMediumTask, true, 4);
+	dLow.start(dLowTask, true, 1);
+	dMedium.start(dMediumTask, true, 4);
+	checker.start(checkerTask, true, 7);
+	Api::startKernel();
+	return 1;
+}
@@ -0,0 +1,113 @@
+/*MIT License
+
+Copyright (c) 2019 Florian GERARD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Except as contained in this notice, the name of Florian GERARD shall not be used 
+in advertising or otherwise to promote the sale, use or other dealings in this 
+Software without prior written authorization from Florian GERARD
+
+*/
+#include "core/Core.hpp"
+#include "yggdrasil/kernel/Api.hpp"
+#include "yggdrasil/kernel/Periodic.hpp"
+#include "HostTest.hpp"
+
+/* Periodic releases, on virtual time
+ * a body of variable length, preempting a background load, is released on start + k * period ticks, never later in time
+ * than kernel costs, a body as long as the period is still on time, a body of 2.5 periods misses 2 releases */
+
+using namespace kernel;
+using core::Simulation;
+
+namespace
+{
+	constexpr uint32_t period = 10; // ticks
+	constexpr uint32_t onTimeReleases = 50;
+	constexpr uint64_t maxLateness = 20; // us, kernel costs only
+
+	Task<512> periodic, background;
+
+	uint64_t lateness(uint64_t tick)
+	{
+		return (Simulation::now() - Simulation::tickTime(tick)) / Simulation::microseconds(1);
+	}
+
+	void consumeMicroseconds(uint64_t us)
+	{
+		Simulation::consume(Simulation::microseconds(us));
+	}
+
+	void periodicTask(uint32_t)
+	{
+		uint64_t start = Api::getTicks();
+		Periodic release(period, start);
+		uint64_t worstLateness = 0;
+		for (uint32_t k = 1; k <= onTimeReleases; k++)
+		{
+			consumeMicroseconds((k * 1700) % 9000); // variable load, below one period
+			HOST_CHECK(release.waitNextPeriod() == 0);
+			HOST_CHECK(release.lastRelease() == start + k * period);
+			HOST_CHECK(Api::getTicks() == start + k * period);
+			uint64_t late = lateness(start + k * period);
+			if (late > worstLateness)
+				worstLateness = late;
+		}
+		HOST_CHECK(worstLateness <= maxLateness);
+		HOST_CHECK(release.overruns() == 0);
+
+		// body lasting exactly one period: next release is now, no overrun
+		uint64_t released = release.lastRelease();
+		consumeMicroseconds(period * 1000);
+		HOST_CHECK(release.waitNextPeriod() == 0);
+		HOST_CHECK(release.lastRelease() == released + period);
+		HOST_CHECK(Api::getTicks() == released + period);
+
+		// body lasting 2.5 periods: two releases are missed, third one is kept on the grid
+		released = release.lastRelease();
+		consumeMicroseconds(period * 2500);
+		HOST_CHECK(release.waitNextPeriod() == 2);
+		HOST_CHECK(release.overruns() == 2);
+		HOST_CHECK(release.lastRelease() == released + 3 * period);
+		HOST_CHECK(Api::getTicks() == released + 3 * period);
+		HOST_CHECK(lateness(released + 3 * period) <= maxLateness);
+
+		HOST_CHECK(release.waitNextPeriod() == 0);
+		HOST_CHECK(release.lastRelease() == released + 4 * period);
+		HOST_CHECK(release.lastRelease() == start + (onTimeReleases + 5) * period); // no drift over the whole run
+		printf("worst release lateness %llu us\n", static_cast<unsigned long long>(worstLateness));
+		hosttest::finish("periodic");
+	}
+
+	void backgroundTask(uint32_t)
+	{
+		while (true)
+			consumeMicroseconds(300);
+	}
+} // namespace
+
+int main()
+{
+	Api::setupKernel(1);
+	periodic.start(periodicTask, true, 3);
+	background.start(backgroundTask, true, 1);
+	Api::startKernel();
+	return 1;
+}
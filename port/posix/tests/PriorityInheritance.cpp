@@ -0,0 +1,126 @@
+/*MIT License
+
+Copyright (c) 2019 Florian GERARD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Except as contained in this notice, the name of Florian GERARD shall not be used 
+in advertising or otherwise to promote the sale, use or other dealings in this 
+Software without prior written authorization from Florian GERARD
+
+*/
+#include "core/Core.hpp"
+#include "yggdrasil/kernel/Api.hpp"
+#include "yggdrasil/kernel/Mutex.hpp"
+#include "HostTest.hpp"
+
+/* Bounded blocking time with priority inheritance, on virtual time
+ * low owns inner mutex, chain owns outer mutex and waits for inner one, high waits for outer one,
+ * a medium priority hog becomes ready meanwhile: without transitive inheritance it preempts low and high misses by the hog length,
+ * with it high waits at most the rest of both critical sections */
+
+using namespace kernel;
+using core::Simulation;
+
+namespace
+{
+	constexpr uint64_t lowSection = 2000;	  // us
+	constexpr uint64_t chainSection = 1000; // us, after getting inner mutex
+	constexpr uint64_t hogLength = 20000;	  // us
+
+	Task<512> low, chain, hog, high, checker;
+	Mutex inner, outer;
+	volatile uint64_t maxBlocking = 0;
+	volatile uint32_t blockedLocks = 0;
+	volatile uint32_t highLocks = 0;
+
+	void lowTask(uint32_t)
+	{
+		while (true)
+		{
+			inner.lock();
+			Simulation::consume(Simulation::microseconds(lowSection));
+			inner.release();
+			Api::sleep(5);
+		}
+	}
+
+	void chainTask(uint32_t)
+	{
+		while (true)
+		{
+			Api::sleep(1); // low gets inner first
+			outer.lock();
+			inner.lock();
+			Simulation::consume(Simulation::microseconds(chainSection));
+			inner.release();
+			outer.release();
+			Api::sleep(5);
+		}
+	}
+
+	void hogTask(uint32_t)
+	{
+		while (true)
+		{
+			Api::sleep(2);
+			Simulation::consume(Simulation::microseconds(hogLength));
+		}
+	}
+
+	void highTask(uint32_t)
+	{
+		while (true)
+		{
+			Api::sleep(7);
+			uint64_t start = Simulation::now();
+			outer.lock();
+			uint64_t blocking = Simulation::now() - start;
+			outer.release();
+			highLocks = highLocks + 1;
+			if (blocking != 0)
+				blockedLocks = blockedLocks + 1;
+			if (blocking > maxBlocking)
+				maxBlocking = blocking;
+		}
+	}
+
+	void checkerTask(uint32_t)
+	{
+		Api::sleep(2000);
+		printf("high locks %u, blocked %u, max blocking %llu us, bound %llu us\n", highLocks, blockedLocks,
+			   static_cast<unsigned long long>(maxBlocking / Simulation::microseconds(1)), static_cast<unsigned long long>(lowSection + chainSection));
+		HOST_CHECK(highLocks > 100);
+		HOST_CHECK(blockedLocks > 10); // scenario does produce contention
+		HOST_CHECK(maxBlocking <= Simulation::microseconds(lowSection + chainSection));
+		hosttest::finish("priority inheritance");
+	}
+} // namespace
+
+int main()
+{
+	Api::setupKernel(1);
+	low.start(lowTask, true, 1);
+	chain.start(chainTask, true, 2);
+	hog.start(hogTask, true, 3);
+	high.start(highTask, true, 5);
+	checker.start(checkerTask, true, 7);
+	Api::startKernel();
+	return 1;
+}
@@ -0,0 +1,107 @@
+/*MIT License
+
+Copyright (c) 2019 Florian GERARD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Except as contained in this notice, the name of Florian GERARD shall not be used 
+in advertising or otherwise to promote the sale, use or other dealings in this 
+Software without prior written authorization from Florian GERARD
+
+*/
+#include <cstring>
+#include "core/Core.hpp"
+#include "yggdrasil/kernel/Api.hpp"
+#include "yggdrasil/kernel/RuntimeStats.hpp"
+#include "HostTest.hpp"
+
+/* Runtime statistics, on virtual time
+ * snapshot names every started task, load is what idle task did not run,
+ * even when a task shares idle priority */
+
+using namespace kernel;
+using core::Simulation;
+
+namespace
+{
+	Task<512> busy, background, checker;
+
+	void busyTask(uint32_t)
+	{
+		while (true)
+		{
+			Simulation::consume(Simulation::microseconds(400));
+			Api::sleep(1);
+		}
+	}
+
+	void backgroundTask(uint32_t)
+	{
+		while (true)
+		{
+			Simulation::consume(Simulation::microseconds(200));
+			Api::sleep(1);
+		}
+	}
+
+	const TaskStatistics *find(const TaskStatistics *stats, uint32_t count, const char *name)
+	{
+		for (uint32_t i = 0; i < count; i++)
+		{
+			if (stats[i].name != nullptr && strcmp(stats[i].name, name) == 0)
+				return &stats[i];
+		}
+		return nullptr;
+	}
+
+	void checkerTask(uint32_t)
+	{
+		Api::sleep(1000);
+		TaskStatistics stats[8];
+		uint32_t count = RuntimeStats::snapshot(stats, 8);
+		uint32_t load = RuntimeStats::cpuLoad();
+		HOST_CHECK(count == 4);
+		const TaskStatistics *idle = find(stats, count, "idle");
+		const TaskStatistics *busyStats = find(stats, count, "busy");
+		const TaskStatistics *backgroundStats = find(stats, count, "background");
+		HOST_CHECK(idle != nullptr && busyStats != nullptr && backgroundStats != nullptr);
+		HOST_CHECK(find(stats, count, "checker") != nullptr);
+		if (idle != nullptr && busyStats != nullptr && backgroundStats != nullptr)
+		{
+			printf("load %u, busy %u, background %u, idle %u (hundredths of percent)\n", load, busyStats->load, backgroundStats->load, idle->load);
+			HOST_CHECK(backgroundStats->priority == 0);
+			HOST_CHECK(backgroundStats->load > 1000);
+			HOST_CHECK(busyStats->load > 2000);
+			HOST_CHECK(load + 1 >= 10000 - idle->load && load <= 10000 - idle->load + 1);
+		}
+		// snapshot stops filling at given size but still counts
+		HOST_CHECK(RuntimeStats::snapshot(stats, 1) == 4);
+		hosttest::finish("runtime stats");
+	}
+} // namespace
+
+int main()
+{
+	Api::setupKernel(1);
+	busy.start(busyTask, true, 3, 0, "busy");
+	background.start(backgroundTask, true, 0, 0, "background");
+	checker.start(checkerTask, true, 7, 0, "checker");
+	Api::startKernel();
+	return 1;
+}
@@ -0,0 +1,100 @@
+/*MIT License
+
+Copyright (c) 2019 Florian GERARD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Except as contained in this notice, the name of Florian GERARD shall not be used 
+in advertising or otherwise to promote the sale, use or other dealings in this 
+Software without prior written authorization from Florian GERARD
+
+*/
+#include "core/Core.hpp"
+#include "yggdrasil/kernel/Api.hpp"
+#include "yggdrasil/kernel/Semaphore.hpp"
+#include "HostTest.hpp"
+
+/* Semaphore batched give, on virtual time
+ * five waiters of different priorities block on an empty semaphore,
+ * giving fewer units than waiters wakes the highest priority ones only, in priority order, and counts nothing,
+ * giving more units than waiters wakes the others and counts the rest, a timed take with no unit returns -1 */
+
+using namespace kernel;
+
+namespace
+{
+	constexpr uint32_t waiterCount = 5;
+	constexpr uint32_t maxCount = 10;
+
+	Task<512> waiters[waiterCount], driver;
+	Semaphore semaphore(0, maxCount);
+
+	volatile uint32_t wokenCount = 0;
+	volatile uint32_t wokenOrder[waiterCount]; // priorities of woken waiters, in wake up order
+	volatile int16_t timedResult = 0;
+
+	void waiterTask(uint32_t priority)
+	{
+		int16_t result = semaphore.take();
+		HOST_CHECK(result == 1);
+		wokenOrder[wokenCount] = priority;
+		wokenCount = wokenCount + 1;
+	}
+
+	void driverTask(uint32_t)
+	{
+		Api::sleep(1); // every waiter blocks
+		HOST_CHECK(semaphore.someoneWaiting());
+
+		HOST_CHECK(semaphore.give(3));
+		HOST_CHECK(wokenCount == 0); // driver keeps the cpu, woken waiters are only ready
+		HOST_CHECK(semaphore.count() == 0); // units were handed, not counted
+		Api::sleep(1);
+		HOST_CHECK(wokenCount == 3);
+		HOST_CHECK(wokenOrder[0] == 5 && wokenOrder[1] == 4 && wokenOrder[2] == 3);
+		HOST_CHECK(semaphore.someoneWaiting());
+
+		HOST_CHECK(semaphore.give(6));
+		HOST_CHECK(semaphore.count() == 4); // two units handed to the last waiters
+		HOST_CHECK(!semaphore.someoneWaiting());
+		Api::sleep(1);
+		HOST_CHECK(wokenCount == waiterCount);
+		HOST_CHECK(wokenOrder[3] == 2 && wokenOrder[4] == 1);
+
+		HOST_CHECK(!semaphore.give(maxCount)); // exceeding units are dropped
+		HOST_CHECK(semaphore.count() == maxCount);
+		while (semaphore.tryTake())
+			;
+		HOST_CHECK(semaphore.count() == 0);
+		timedResult = semaphore.take(5);
+		HOST_CHECK(timedResult == -1);
+		hosttest::finish("semaphore");
+	}
+} // namespace
+
+int main()
+{
+	Api::setupKernel(1);
+	// started lowest first, waiting list order comes from priorities only
+	for (uint32_t i = 0; i < waiterCount; i++)
+		waiters[i].start(waiterTask, true, i + 1, i + 1);
+	driver.start(driverTask, true, waiterCount + 2);
+	Api::startKernel();
+	return 1;
+}
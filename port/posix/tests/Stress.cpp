@@ -0,0 +1,235 @@
+/*MIT License
+
+Copyright (c) 2019 Florian GERARD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Except as contained in this notice, the name of Florian GERARD shall not be used 
+in advertising or otherwise to promote the sale, use or other dealings in this 
+Software without prior written authorization from Florian GERARD
+
+*/
+#include <cstdio>
+#include <cstdlib>
+#include <unistd.h>
+#include "core/Core.hpp"
+#include "yggdrasil/kernel/Api.hpp"
+#include "yggdrasil/kernel/Event.hpp"
+#include "yggdrasil/kernel/Mutex.hpp"
+#include "yggdrasil/kernel/Semaphore.hpp"
+#include "yggdrasil/framework/Histogram.hpp"
+#ifdef KERNEL_LATENCY_PROBES
+#include "yggdrasil/kernel/LatencyProbes.hpp"
+#endif
+#include "HostTest.hpp"
+
+/* Stress harness: 10, 100 then 1000 tasks with random priorities sleeping, waiting and signaling events,
+ * taking semaphore units and contending on nested mutexes, tasks are added between phases
+ * built as a test (HOST_SIMULATION, KERNEL_CHECK_INVARIANTS): scheduler state is checked on every switch,
+ * mutual exclusion and progress of every task are checked at each phase end,
+ * latency is how late sleeps end in virtual time
+ * built as a benchmark (KERNEL_LATENCY_PROBES, real time): latency rows come from kernel probes
+ * argument: largest task count (default 1000) */
+
+using namespace kernel;
+
+namespace
+{
+	constexpr uint32_t maxTasks = 1000;
+	constexpr uint32_t phaseTicks = 500;
+	constexpr uint32_t mutexCount = 4;
+	constexpr uint32_t eventCount = 8;
+	constexpr uint32_t driverPriority = config::priorityLevels - 1;
+	constexpr uint32_t maxPriority = config::priorityLevels - 2; // tasks run in [1, maxPriority]
+	static const uint32_t phaseCounts[] = {10, 100, maxTasks};
+
+	Task<256> tasks[maxTasks];
+	Task<1024> driver;
+	Mutex mutexes[mutexCount];
+	Event events[eventCount];
+	Semaphore units(0, 64);
+
+	volatile uint32_t startedTasks = 0;
+	volatile uint32_t iterations[maxTasks];
+	volatile uint32_t holders[mutexCount]; // task index + 1 of mutex owner, 0 if free
+	volatile uint32_t exclusionFailures = 0;
+	volatile uint32_t lockTimeouts = 0, waitTimeouts = 0;
+	framework::Histogram<4> lateness; // us
+
+	uint32_t nextRandom(uint32_t &state)
+	{
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+		return state;
+	}
+
+	void work(uint32_t &state)
+	{
+#ifdef HOST_SIMULATION
+		core::Simulation::consume(core::Simulation::microseconds(20 + nextRandom(state) % 40));
+#else
+		(void)state;
+#endif
+	}
+
+	void sleepFor(uint32_t ticks)
+	{
+#ifdef HOST_SIMULATION
+		uint64_t wakeTick = Api::getTicks() + ticks;
+		Api::sleep(ticks);
+		uint64_t late = core::Simulation::now() - core::Simulation::tickTime(wakeTick);
+		lateness.record(static_cast<uint32_t>(late / core::Simulation::microseconds(1)));
+#else
+		Api::sleep(ticks);
+#endif
+	}
+
+	// mutex section, checks nobody else got in meanwhile
+	void holdMutex(uint32_t index, uint32_t mutex, uint32_t &state)
+	{
+		holders[mutex] = index + 1;
+		work(state);
+		if ((nextRandom(state) & 7) == 0)
+			Api::sleep(0); // owner blocks while holding, others pile up on the mutex
+		if (holders[mutex] != index + 1)
+			exclusionFailures = exclusionFailures + 1;
+	}
+
+	void stressTask(uint32_t index)
+	{
+		uint32_t state = 2463534242u ^ (index * 2654435761u);
+		while (true)
+		{
+			uint32_t action = nextRandom(state) % 8;
+			uint32_t first = nextRandom(state) % mutexCount;
+			uint32_t event = nextRandom(state) % eventCount;
+			switch (action)
+			{
+			case 0:
+			case 1:
+				break; // sleep only
+			case 2:
+				if (events[event].wait(1 + nextRandom(state) % 10) < 0)
+					waitTimeouts = waitTimeouts + 1;
+				break;
+			case 3:
+				events[event].signal();
+				break;
+			case 4:
+				if (mutexes[first].lock(1 + nextRandom(state) % 20) < 0)
+				{
+					lockTimeouts = lockTimeouts + 1;
+					break;
+				}
+				holdMutex(index, first, state);
+				mutexes[first].release();
+				break;
+			case 5:
+				// nested, always in index order
+				if (first + 1 < mutexCount)
+				{
+					mutexes[first].lock();
+					holdMutex(index, first, state);
+					mutexes[first + 1].lock();
+					holdMutex(index, first + 1, state);
+					mutexes[first + 1].release();
+					mutexes[first].release();
+				}
+				break;
+			case 6:
+				units.give();
+				break;
+			default:
+				units.take(1 + nextRandom(state) % 5);
+				break;
+			}
+			work(state);
+			iterations[index] = iterations[index] + 1;
+			// average sleep grows with task count, processor load stays around 40 %
+			uint32_t longest = (startedTasks / 5 > 2) ? startedTasks / 5 : 2;
+			sleepFor(1 + nextRandom(state) % longest);
+		}
+	}
+
+	void printRow(uint32_t count, const char *latency, uint32_t samples, uint32_t mean, uint32_t median, uint32_t percentile99, uint32_t maximum)
+	{
+		printf("%u,%s,%u,%u,%u,%u,%u\n", count, latency, samples, mean, median, percentile99, maximum);
+	}
+
+	void driverTask(uint32_t largest)
+	{
+		static uint32_t before[maxTasks];
+		printf("tasks,latency,count,avg,p50,p99,max\n");
+		for (uint32_t count : phaseCounts)
+		{
+			if (count > largest)
+				count = largest;
+			if (count <= startedTasks)
+				break;
+			for (uint32_t i = startedTasks; i < count; i++)
+			{
+				uint32_t priority = 1 + (i * 2654435761u >> 16) % maxPriority;
+				tasks[i].start(stressTask, true, priority, i);
+				startedTasks = i + 1;
+			}
+			for (uint32_t i = 0; i < count; i++)
+				before[i] = iterations[i];
+			lateness.reset();
+#ifdef KERNEL_LATENCY_PROBES
+			LatencyProbes::reset();
+#endif
+			Api::sleep(phaseTicks);
+
+			uint32_t stalled = 0;
+			for (uint32_t i = 0; i < count; i++)
+			{
+				if (iterations[i] == before[i])
+					stalled++;
+			}
+			HOST_CHECK(stalled == 0);
+			HOST_CHECK(exclusionFailures == 0);
+#ifdef HOST_SIMULATION
+			printRow(count, "sleep lateness us", lateness.count(), lateness.mean(), lateness.percentile(500), lateness.percentile(990), lateness.maximum());
+#endif
+#ifdef KERNEL_LATENCY_PROBES
+			for (uint32_t probe = 0; probe < static_cast<uint32_t>(LatencyProbe::count); probe++)
+			{
+				LatencyStatistics statistics;
+				if (LatencyProbes::snapshot(static_cast<LatencyProbe>(probe), statistics))
+					printRow(count, LatencyProbes::name(static_cast<LatencyProbe>(probe)), statistics.count, statistics.mean, statistics.median, statistics.percentile99, statistics.maximum);
+			}
+#endif
+			fflush(stdout);
+		}
+		printf("lock timeouts %u, wait timeouts %u\n", lockTimeouts, waitTimeouts);
+		hosttest::finish("stress");
+	}
+} // namespace
+
+int main(int argc, char **argv)
+{
+	uint32_t largest = (argc > 1) ? static_cast<uint32_t>(strtoul(argv[1], nullptr, 0)) : maxTasks;
+	if (largest > maxTasks)
+		largest = maxTasks;
+	Api::setupKernel(1);
+	driver.start(driverTask, true, driverPriority, largest);
+	Api::startKernel();
+	return 1;
+}
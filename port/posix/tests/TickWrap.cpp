@@ -0,0 +1,123 @@
+/*MIT License
+
+Copyright (c) 2019 Florian GERARD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Except as contained in this notice, the name of Florian GERARD shall not be used 
+in advertising or otherwise to promote the sale, use or other dealings in this 
+Software without prior written authorization from Florian GERARD
+
+*/
+#include "core/Core.hpp"
+#include "yggdrasil/kernel/Api.hpp"
+#include "yggdrasil/kernel/Event.hpp"
+#include "HostTest.hpp"
+
+/* Kernel time across the carry out of its low word, on virtual time, built with KERNEL_INITIAL_TICKS close to 2^32
+ * sleeps, sleepUntil and wait timeouts spanning the carry end on the exact tick, a short sleep repeated over the carry
+ * never drifts and getTicks read in a loop by a busy task never goes back nor jumps */
+
+using namespace kernel;
+using core::Simulation;
+
+namespace
+{
+	constexpr uint64_t carry = 0x100000000ULL;
+	static_assert(config::initialTicks < carry && carry - config::initialTicks <= 0x10000, "start kernel time close below 2^32");
+
+	Task<512> sleeper, stepper, reader, checker;
+	Event neverSignaled;
+
+	volatile bool sleeperDone = false, stepperDone = false;
+	volatile uint32_t readerBackward = 0, readerJumps = 0, readerReads = 0;
+	volatile uint64_t readerLast = 0;
+
+	void sleeperTask(uint32_t)
+	{
+		HOST_CHECK(Api::getTicks() == config::initialTicks);
+		uint64_t before = Api::getTicks();
+		uint32_t toCarry = static_cast<uint32_t>(carry - before);
+		Api::sleep(toCarry + 5); // low word wraps while sleeping
+		HOST_CHECK(Api::getTicks() == carry + 5);
+
+		HOST_CHECK(Api::sleepUntil(carry + 40));
+		HOST_CHECK(Api::getTicks() == carry + 40);
+		HOST_CHECK(!Api::sleepUntil(carry + 40)); // reached, no sleep
+		HOST_CHECK(!Api::sleepUntil(carry - 1)); // high word counts, not only the low one
+		sleeperDone = true;
+	}
+
+	// short steps from before the carry to after it, each one ends exactly 7 ticks later, with a timed wait in the middle
+	void stepperTask(uint32_t)
+	{
+		Api::sleepUntil(carry - 100);
+		uint64_t expected = carry - 100;
+		HOST_CHECK(Api::getTicks() == expected);
+		while (expected < carry + 100)
+		{
+			if (expected >= carry - 10 && expected < carry - 3)
+				HOST_CHECK(neverSignaled.wait(20) == -1); // timeout spans the carry
+			else
+				Api::sleep(7);
+			expected += (expected >= carry - 10 && expected < carry - 3) ? 20 : 7;
+			HOST_CHECK(Api::getTicks() == expected);
+		}
+		stepperDone = true;
+	}
+
+	void readerTask(uint32_t)
+	{
+		readerLast = Api::getTicks();
+		while (true)
+		{
+			uint64_t now = Api::getTicks();
+			if (now < readerLast)
+				readerBackward = readerBackward + 1;
+			if (now > readerLast + 1)
+				readerJumps = readerJumps + 1;
+			readerLast = now;
+			readerReads = readerReads + 1;
+			Simulation::consume(Simulation::microseconds(50));
+		}
+	}
+
+	void checkerTask(uint32_t)
+	{
+		HOST_CHECK(Api::sleepUntil(carry + 200));
+		HOST_CHECK(sleeperDone);
+		HOST_CHECK(stepperDone);
+		HOST_CHECK(readerReads > 1000);
+		HOST_CHECK(readerBackward == 0);
+		HOST_CHECK(readerJumps == 0);
+		HOST_CHECK(readerLast >= carry + 199);
+		hosttest::finish("tick wrap");
+	}
+} // namespace
+
+int main()
+{
+	Api::setupKernel(1);
+	sleeper.start(sleeperTask, true, 3);
+	stepper.start(stepperTask, true, 4);
+	reader.start(readerTask, true, 1);
+	checker.start(checkerTask, true, 5);
+	Api::startKernel();
+	return 1;
+}
@@ -0,0 +1,137 @@
+/*MIT License
+
+Copyright (c) 2019 Florian GERARD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Except as contained in this notice, the name of Florian GERARD shall not be used 
+in advertising or otherwise to promote the sale, use or other dealings in this 
+Software without prior written authorization from Florian GERARD
+
+*/
+#include "core/Core.hpp"
+#include "yggdrasil/kernel/Api.hpp"
+#include "yggdrasil/kernel/Mutex.hpp"
+#include "HostTest.hpp"
+
+/* Round robin time slicing, on virtual time
+ * three busy tasks of a same priority rotate in order, each quantum being 5 ticks, and share the processor evenly,
+ * then they lock a ceiling mutex of their own level for part of each quantum: a task holding it is not sliced,
+ * so a peer never finds it locked, and tasks still rotate */
+
+using namespace kernel;
+using core::Simulation;
+
+namespace
+{
+	constexpr uint32_t peerCount = 3;
+	constexpr uint32_t peerPriority = 2;
+	constexpr uint32_t quantum = 5; // ticks
+	constexpr uint32_t phaseTicks = 300;
+	constexpr uint32_t maxTurns = 256;
+
+	Task<512> peers[peerCount], checker;
+	CeilingMutex ceiling(peerPriority);
+
+	volatile bool inCeilingPhase = false;
+	volatile uint32_t lastRunner = peerCount;
+	volatile uint32_t turns = 0;
+	volatile uint32_t turnOrder[maxTurns]; // running peer at each switch
+	volatile uint64_t runTime[peerCount]; // us
+	volatile uint32_t refusedLocks = 0;
+
+	void run(uint32_t index, uint64_t us)
+	{
+		if (lastRunner != index)
+		{
+			if (turns < maxTurns)
+				turnOrder[turns] = index;
+			turns = turns + 1;
+			lastRunner = index;
+		}
+		Simulation::consume(Simulation::microseconds(us));
+		runTime[index] = runTime[index] + us;
+	}
+
+	void peerTask(uint32_t index)
+	{
+		while (true)
+		{
+			if (!inCeilingPhase)
+			{
+				run(index, 100);
+				continue;
+			}
+			if (ceiling.lock() != 1)
+			{
+				refusedLocks = refusedLocks + 1;
+				run(index, 100);
+				continue;
+			}
+			run(index, 3000); // often outlasts quantum
+			ceiling.release();
+			run(index, 100);
+		}
+	}
+
+	// turns went 0, 1, 2, 0... from the first recorded one
+	bool rotatedInOrder(uint32_t from, uint32_t to)
+	{
+		for (uint32_t i = from + 1; i < to && i < maxTurns; i++)
+		{
+			if (turnOrder[i] != (turnOrder[i - 1] + 1) % peerCount)
+				return false;
+		}
+		return true;
+	}
+
+	void checkerTask(uint32_t)
+	{
+		Api::setTimeSlice(peerPriority, quantum);
+		Api::sleep(phaseTicks);
+		uint32_t slicedTurns = turns;
+		HOST_CHECK(slicedTurns >= phaseTicks / quantum - 2 && slicedTurns <= phaseTicks / quantum + 2);
+		HOST_CHECK(rotatedInOrder(0, slicedTurns));
+		uint64_t total = runTime[0] + runTime[1] + runTime[2];
+		for (uint32_t i = 0; i < peerCount; i++)
+		{
+			HOST_CHECK(runTime[i] * peerCount >= total - total / 10); // even share, within 10 %
+			HOST_CHECK(runTime[i] * peerCount <= total + total / 10);
+		}
+
+		inCeilingPhase = true;
+		Api::sleep(phaseTicks);
+		HOST_CHECK(refusedLocks == 0);
+		HOST_CHECK(turns > slicedTurns + phaseTicks / (2 * quantum)); // still rotating
+		HOST_CHECK(rotatedInOrder(slicedTurns, turns));
+		printf("turns %u then %u, run time %llu %llu %llu us\n", slicedTurns, turns - slicedTurns, static_cast<unsigned long long>(runTime[0]),
+			   static_cast<unsigned long long>(runTime[1]), static_cast<unsigned long long>(runTime[2]));
+		hosttest::finish("time slice");
+	}
+} // namespace
+
+int main()
+{
+	Api::setupKernel(1);
+	for (uint32_t i = 0; i < peerCount; i++)
+		peers[i].start(peerTask, true, peerPriority, i);
+	checker.start(checkerTask, true, peerPriority + 3);
+	Api::startKernel();
+	return 1;
+}
@@ -0,0 +1,115 @@
+/*MIT License
+
+Copyright (c) 2019 Florian GERARD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Except as contained in this notice, the name of Florian GERARD shall not be used 
+in advertising or otherwise to promote the sale, use or other dealings in this 
+Software without prior written authorization from Florian GERARD
+
+*/
+#include <cstring>
+#include "core/Core.hpp"
+#include "yggdrasil/kernel/Api.hpp"
+#include "yggdrasil/kernel/Mutex.hpp"
+#include "yggdrasil/kernel/Trace.hpp"
+#include "HostTest.hpp"
+
+/* Kernel trace, on virtual time
+ * task names are rebuilt from name records, a mutex timeout is recorded once */
+
+using namespace kernel;
+
+namespace
+{
+	Task<512> holder, waiter, checker;
+	Mutex mutex;
+	volatile int16_t lockResult = 0;
+
+	void holderTask(uint32_t)
+	{
+		mutex.lock();
+		Api::sleep(20);
+		mutex.release();
+	}
+
+	void waiterTask(uint32_t)
+	{
+		Api::sleep(1);
+		lockResult = mutex.lock(5);
+	}
+
+	// name of task with trace id, from its name records
+	bool nameOf(const TraceBuffer &buffer, uint8_t id, char *name, uint32_t size)
+	{
+		uint32_t length = 0;
+		for (uint32_t i = 0; i < buffer.written && i < buffer.capacity; i++)
+		{
+			const TraceRecord &record = buffer.records[i];
+			if (record.event != TraceEvent::taskName || record.task != id)
+				continue;
+			for (uint32_t c = 0; c < 4 && length + 1 < size; c++)
+				name[length++] = static_cast<char>(record.argument >> (8 * c));
+		}
+		name[length] = '\0';
+		return length != 0;
+	}
+
+	void checkerTask(uint32_t)
+	{
+		Api::sleep(50);
+		const TraceBuffer &buffer = Trace::buffer();
+		HOST_CHECK(buffer.magic == Trace::magic);
+		HOST_CHECK(buffer.written < buffer.capacity); // nothing overwritten, whole run is read
+		HOST_CHECK(lockResult == -1);
+
+		uint32_t timeouts = 0;
+		uint8_t waiterId = 0;
+		for (uint32_t i = 0; i < buffer.written && i < buffer.capacity; i++)
+		{
+			const TraceRecord &record = buffer.records[i];
+			if (record.event == TraceEvent::mutexTimeout)
+			{
+				timeouts++;
+				waiterId = record.task;
+				HOST_CHECK(record.argument == static_cast<uint32_t>(reinterpret_cast<uintptr_t>(&mutex)));
+			}
+		}
+		HOST_CHECK(timeouts == 1);
+
+		char name[32];
+		HOST_CHECK(nameOf(buffer, waiterId, name, sizeof(name)) && strcmp(name, "waiter") == 0);
+		bool holderNamed = false;
+		for (uint8_t id = 1; id < 8; id++)
+			holderNamed = holderNamed || (nameOf(buffer, id, name, sizeof(name)) && strcmp(name, "holder") == 0);
+		HOST_CHECK(holderNamed);
+		hosttest::finish("trace");
+	}
+} // namespace
+
+int main()
+{
+	Api::setupKernel(1);
+	holder.start(holderTask, true, 2, 0, "holder");
+	waiter.start(waiterTask, true, 3, 0, "waiter");
+	checker.start(checkerTask, true, 7, 0, "checker");
+	Api::startKernel();
+	return 1;
+}
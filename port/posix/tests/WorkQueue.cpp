@@ -0,0 +1,109 @@
+/*MIT License
+
+Copyright (c) 2019 Florian GERARD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Except as contained in this notice, the name of Florian GERARD shall not be used 
+in advertising or otherwise to promote the sale, use or other dealings in this 
+Software without prior written authorization from Florian GERARD
+
+*/
+#include "core/Core.hpp"
+#include "yggdrasil/kernel/Api.hpp"
+#include "yggdrasil/kernel/Semaphore.hpp"
+#include "yggdrasil/kernel/WorkQueue.hpp"
+#include "HostTest.hpp"
+
+/* Work queue, on virtual time
+ * a full queue drops posts and reports it, an interrupt post whose wake up is lost reports it too,
+ * its work is kept and runs with the next post */
+
+using namespace kernel;
+using core::Simulation;
+
+namespace
+{
+	constexpr core::interfaces::Irq testIrq = 3;
+	constexpr uint32_t slots = 8;
+
+	Task<512> driver, checker;
+	WorkQueue<512, slots> workQueue("works");
+	Semaphore filler(0, 1000);
+
+	volatile uint32_t executed = 0;
+	volatile uint32_t lastContext = 0;
+	volatile bool isrPostResult = true;
+	volatile bool driverDone = false;
+
+	void work(uint32_t context)
+	{
+		executed = executed + 1;
+		lastContext = context;
+	}
+
+	void irqHandler()
+	{
+		for (uint32_t i = 0; i < config::isrRequestSlots; i++)
+			filler.giveFromIsr();
+		isrPostResult = workQueue.post(work, 100);
+	}
+
+	void driverTask(uint32_t)
+	{
+		// worker runs below driver: posts pile up until driver sleeps
+		for (uint32_t i = 0; i < slots; i++)
+			HOST_CHECK(workQueue.post(work, i));
+		HOST_CHECK(!workQueue.post(work, slots)); // full
+		Api::sleep(1);
+		HOST_CHECK(executed == slots);
+		HOST_CHECK(lastContext == slots - 1);
+
+		// interrupt posts with interrupt requests full, at 10 ms
+		Api::sleep(15);
+		HOST_CHECK(!isrPostResult);
+		HOST_CHECK(executed == slots); // kept, not run
+
+		HOST_CHECK(workQueue.post(work, 101));
+		Api::sleep(1);
+		HOST_CHECK(executed == slots + 2);
+		HOST_CHECK(lastContext == 101);
+		driverDone = true;
+	}
+
+	void checkerTask(uint32_t)
+	{
+		Api::sleep(50);
+		HOST_CHECK(driverDone);
+		hosttest::finish("work queue");
+	}
+} // namespace
+
+int main()
+{
+	Api::setupKernel(1);
+	workQueue.start(2);
+	driver.start(driverTask, true, 3);
+	checker.start(checkerTask, true, 7);
+	Api::setupInterrupt(testIrq, irqHandler, 4);
+	Api::enableIrq(testIrq);
+	Simulation::injectIrq(Simulation::microseconds(10000), testIrq);
+	Api::startKernel();
+	return 1;
+}
@@ -0,0 +1,117 @@
+#!/usr/bin/env python3
+"""Decode a Yggdrasil kernel trace dump into Chrome / Perfetto trace JSON.
+
+Build the kernel with KERNEL_TRACE, then dump kernel::Trace::s_buffer as a
+whole, for instance from gdb:
+    dump binary memory trace.bin &kernel::Trace::s_buffer ((char*)&kernel::Trace::s_buffer)+sizeof(kernel::Trace::s_buffer)
+and convert it:
+    trace_decode.py trace.bin -o trace.json
+Open trace.json in chrome://tracing or https://ui.perfetto.dev.
+"""
+
+import argparse
+import json
+import struct
+import sys
+
+MAGIC = 0x43525459
+VERSION = 1
+HEADER = struct.Struct("<IHHIII")
+RECORD = struct.Struct("<IHBBI")
+
+EVENTS = [
+    "kernelStart", "taskStart", "taskName", "taskStartExec", "taskStopExec", "taskClose",
+    "taskReady", "taskSleep", "taskWaitEvent", "eventTrigger", "eventTimeout",
+    "mutexLock", "mutexRelease", "mutexWait", "mutexTimeout",
+    "semaphoreTake", "semaphoreGive", "semaphoreWait", "semaphoreTimeout",
+    "queueSend", "queueReceive", "queueWait", "queueTimeout",
+    "eventGroupSet", "eventGroupWait", "eventGroupTimeout",
+    "taskNotify", "notificationWait", "notificationTimeout",
+]
+TASK_START, TASK_NAME, TASK_START_EXEC = 1, 2, 3
+
+
+def read_records(data):
+    """Return header fields and records ordered from oldest to newest."""
+    if len(data) < HEADER.size:
+        sys.exit("dump is shorter than trace header")
+    magic, version, record_size, capacity, written, frequency = HEADER.unpack_from(data)
+    if magic != MAGIC:
+        sys.exit("not a kernel trace dump (bad magic 0x%08x)" % magic)
+    if version != VERSION or record_size != RECORD.size:
+        sys.exit("unsupported trace version %d, record size %d" % (version, record_size))
+    if len(data) < HEADER.size + capacity * record_size:
+        sys.exit("dump is truncated, expected %d records" % capacity)
+    count = min(written, capacity)
+    first = written - count
+    records = []
+    for index in range(first, written):
+        offset = HEADER.size + (index % capacity) * record_size
+        low, high, event, task, argument = RECORD.unpack_from(data, offset)
+        records.append(((high << 32) | low, event, task, argument))
+    return frequency, records, written - count
+
+
+def unwrap(records):
+    """Timestamps are 48 bits wide, extend them assuming less than one wrap between records."""
+    wrap = 1 << 48
+    offset, previous = 0, None
+    for timestamp, event, task, argument in records:
+        if previous is not None and timestamp + offset < previous:
+            offset += wrap
+        previous = timestamp + offset
+        yield previous, event, task, argument
+
+
+def convert(frequency, records):
+    if frequency == 0:
+        frequency = 1000000  # kernel not started when dumped, show cycles as microseconds
+    to_us = 1000000.0 / frequency
+    names = {0: "kernel"}
+    pending_names = {}
+    events = []
+    running = None  # (task, start time) of current execution slice
+    for timestamp, event, task, argument in unwrap(records):
+        ts = timestamp * to_us
+        if event == TASK_START:
+            pending_names[task] = b""
+            continue
+        if event == TASK_NAME:
+            chunk = struct.pack("<I", argument).split(b"\0")[0]
+            pending_names[task] = pending_names.get(task, b"") + chunk
+            names[task] = pending_names[task].decode("ascii", "replace") or "task %d" % task
+            continue
+        if event == TASK_START_EXEC:
+            if running is not None:
+                events.append({"name": names.get(running[0], "task %d" % running[0]), "ph": "X", "pid": 1,
+                               "tid": running[0], "ts": running[1], "dur": ts - running[1]})
+            running = (task, ts)
+            continue
+        name = EVENTS[event] if event < len(EVENTS) else "event %d" % event
+        events.append({"name": name, "ph": "i", "s": "t", "pid": 1, "tid": task, "ts": ts,
+                       "args": {"argument": "0x%08x" % argument}})
+    for task, name in names.items():
+        events.append({"name": "thread_name", "ph": "M", "pid": 1, "tid": task, "args": {"name": name}})
+    events.append({"name": "process_name", "ph": "M", "pid": 1, "args": {"name": "yggdrasil"}})
+    return {"traceEvents": events, "displayTimeUnit": "ns"}
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("dump", help="binary dump of kernel::Trace::s_buffer")
+    parser.add_argument("-o", "--output", help="output JSON file, standard output if omitted")
+    options = parser.parse_args()
+    with open(options.dump, "rb") as dump:
+        frequency, records, lost = read_records(dump.read())
+    if lost:
+        print("%d oldest records were overwritten" % lost, file=sys.stderr)
+    trace = convert(frequency, records)
+    if options.output:
+        with open(options.output, "w") as output:
+            json.dump(trace, output)
+    else:
+        json.dump(trace, sys.stdout)
+
+
+if __name__ == "__main__":
+    main()